@@ -1,20 +1,37 @@
 """Speech features using TFLite Micro audio frontend."""
 
+from array import array
 from dataclasses import dataclass
-from typing import List
+from typing import TYPE_CHECKING
 
 # pylint: disable=no-name-in-module
-from micro_features_cpp import create_frontend, process_samples, reset_frontend
+from micro_features_cpp import (
+    create_frontend,
+    process_audio,
+    process_samples,
+    reset_frontend,
+)
+
+if TYPE_CHECKING:
+    from typing_extensions import Buffer
 
 
 @dataclass
 class MicroFrontendOutput:
     """Output from ProcessSamples."""
 
-    features: List[float]
+    features: "array[float]"
     samples_read: int
 
 
+@dataclass
+class MicroFrontendAudioOutput:
+    """Output from process_audio."""
+
+    features: memoryview
+    bytes_read: int
+
+
 class MicroFrontend:
     """TFLite Micro audio frontend."""
 
@@ -22,11 +39,24 @@ class MicroFrontend:
         """Initialize frontend."""
         self._frontend = create_frontend()
 
-    def process_samples(self, audio: bytes) -> MicroFrontendOutput:
-        """Process 16Khz 16-bit audio samples."""
+    def process_samples(self, audio: "Buffer") -> MicroFrontendOutput:
+        """Process 16Khz 16-bit audio samples.
+
+        Audio is any C-contiguous buffer of bytes or int16 samples.
+        """
         features, samples_read = process_samples(self._frontend, audio)
         return MicroFrontendOutput(features, samples_read)
 
+    def process_audio(self, audio: "Buffer") -> MicroFrontendAudioOutput:
+        """Process any amount of 16Khz 16-bit audio samples in one call.
+
+        Features are a float32 view with shape [frames, 40], or empty if no
+        frame was completed. Samples after the last frame are kept for the
+        next call.
+        """
+        features, bytes_read = process_audio(self._frontend, audio)
+        return MicroFrontendAudioOutput(features, bytes_read)
+
     def reset(self) -> None:
         """Reset state."""
         reset_frontend(self._frontend)
@@ -1,3 +1,4 @@
+import sys
 from pathlib import Path
 
 # Available at setup time due to pyproject.toml
@@ -14,21 +15,47 @@ sources = []
 sources.extend(
     _FRONTEND_DIR / f
     for f in [
+        "cpu_features.cc",
         "kiss_fft_int16.cc",
         "fft.cc",
+        "fft_backend.cc",
+        "fft_multi.cc",
+        "fft_plan_cache.cc",
+        "fft_pow2.cc",
+        "fft_pow2_avx2.cc",
+        "fft_pow2_avx512.cc",
+        "fft_pow2_sse41.cc",
         "fft_util.cc",
         "filterbank.cc",
+        "filterbank_avx2.cc",
+        "filterbank_avx512.cc",
+        "filterbank_sse41.cc",
         "filterbank_util.cc",
+        "float_spectrum.cc",
+        "float_spectrum_util.cc",
         "frontend.cc",
+        "frontend_offline.cc",
         "frontend_util.cc",
         "log_lut.cc",
         "log_scale.cc",
+        "log_scale_avx2.cc",
+        "log_scale_avx512.cc",
+        "log_scale_sse41.cc",
         "log_scale_util.cc",
         "noise_reduction.cc",
+        "noise_reduction_avx2.cc",
+        "noise_reduction_avx512.cc",
+        "noise_reduction_sse41.cc",
         "noise_reduction_util.cc",
         "pcan_gain_control.cc",
+        "pcan_gain_control_avx2.cc",
+        "pcan_gain_control_avx512.cc",
+        "pcan_gain_control_sse41.cc",
         "pcan_gain_control_util.cc",
         "window.cc",
+        "window_avx2.cc",
+        "window_avx512.cc",
+        "window_sse41.cc",
         "window_util.cc",
     ]
 )
@@ -36,6 +63,14 @@ sources.append(_KISSFFT_DIR / "kiss_fft.cc")
 sources.append(_KISSFFT_DIR / "tools" / "kiss_fftr.cc")
 
 flags = ["-DFIXED_POINT=16"]
+
+# Target the oldest stable ABI that has the buffer protocol for audio input
+# (3.11) when building on it, and 3.9 otherwise, which copies non-bytes audio
+if sys.version_info >= (3, 11):
+    limited_api, limited_api_tag = "0x030B0000", "cp311"
+else:
+    limited_api, limited_api_tag = "0x03090000", "cp39"
+
 ext_modules = [
     Extension(
         name="micro_features_cpp",
@@ -46,7 +81,7 @@ ext_modules = [
             [str(p) for p in sources] + [str(_DIR / "src" / "micro_features.cpp")]
         ),
         define_macros=[
-            ("Py_LIMITED_API", "0x03090000"),
+            ("Py_LIMITED_API", limited_api),
             ("VERSION_INFO", f'"{version}"'),
         ],
         include_dirs=[str(_INCLUDE_DIR), str(_KISSFFT_DIR)],
@@ -57,6 +92,7 @@ ext_modules = [
 setup(
     version=version,
     ext_modules=ext_modules,
+    options={"bdist_wheel": {"py_limited_api": limited_api_tag}},
     extras_require={
         "dev": [
             "black",
@@ -1,13 +1,22 @@
 // src/micro_features.cpp
 #define PY_SSIZE_T_CLEAN
 #ifndef Py_LIMITED_API
-// Target Python 3.9 stable ABI (adjust if you set a different floor)
+// Target Python 3.9 stable ABI (setup.py picks 3.11 when building on it)
 #define Py_LIMITED_API 0x03090000
 #endif
 #include <Python.h>
 
+#include <stdint.h>
+#include <string.h>
+
+// The buffer protocol is only in the stable ABI from Python 3.11 on
+#if !defined(Py_LIMITED_API) || Py_LIMITED_API >= 0x030B0000
+#define HAVE_BUFFER_PROTOCOL 1
+#endif
+
 extern "C" {
 #include "tensorflow/lite/experimental/microfrontend/lib/frontend.h"
+#include "tensorflow/lite/experimental/microfrontend/lib/frontend_offline.h"
 #include "tensorflow/lite/experimental/microfrontend/lib/frontend_util.h"
 }
 
@@ -31,6 +40,12 @@ struct FrontendHandle {
 
 static const char *CAPSULE_NAME = "micro_features_cpp.FrontendHandle";
 
+// array.array and its float32 type code, looked up once at import. Features
+// are returned as array('f'), a compact buffer that numpy can view without
+// copying, instead of a list of separate float objects.
+static PyObject *array_type = NULL;
+static PyObject *float_typecode = NULL;
+
 // -------------------- helpers --------------------
 static inline void init_cfg(FrontendConfig *cfg) {
     cfg->window.size_ms = FEATURE_DURATION_MS;
@@ -52,6 +67,14 @@ static inline void init_cfg(FrontendConfig *cfg) {
 
     cfg->log_scale.enable_log = 1;
     cfg->log_scale.scale_shift = 6;
+
+    cfg->use_float_engine = 0;
+    cfg->incremental_fft = 0;
+    cfg->fft_backend = NULL;
+    cfg->num_heads = 0;
+    cfg->heads = NULL;
+    cfg->emit_stride = 1;
+    cfg->emit_phase = 0;
 }
 
 static void frontend_capsule_destructor(PyObject *capsule) {
@@ -74,6 +97,135 @@ static inline FrontendHandle *get_handle(PyObject *cap) {
     return (FrontendHandle *)PyCapsule_GetPointer(cap, CAPSULE_NAME);
 }
 
+// New array('f') holding a copy of the values.
+static PyObject *new_float_array(const float *values, size_t count) {
+    PyObject *bytes = PyBytes_FromStringAndSize(
+        (const char *)values, (Py_ssize_t)(count * sizeof(float)));
+    if (!bytes)
+        return NULL;
+    PyObject *array = PyObject_CallFunctionObjArgs(array_type, float_typecode,
+                                                   bytes, NULL);
+    Py_DECREF(bytes);
+    return array;
+}
+
+// Whether a buffer format is raw bytes or native 16-bit samples (NULL means
+// unsigned bytes)
+static bool is_audio_format(const char *format) {
+    if (!format)
+        return true;
+    if (format[0] == '@' || format[0] == '=') {
+        ++format;
+    } else if (format[0] == '<' || format[0] == '>' || format[0] == '!') {
+        const uint16_t one = 1;
+        const bool little_endian = *(const uint8_t *)&one == 1;
+        if (little_endian != (format[0] == '<'))
+            return false;
+        ++format;
+    }
+    return strcmp(format, "h") == 0 || strcmp(format, "B") == 0 ||
+           strcmp(format, "b") == 0 || strcmp(format, "c") == 0;
+}
+
+// 16-bit samples read from a Python object for the length of a call
+struct AudioSamples {
+    const int16_t *samples;
+    Py_ssize_t len; // in bytes
+#ifdef HAVE_BUFFER_PROTOCOL
+    Py_buffer view;
+#else
+    PyObject *bytes;
+#endif
+    // Aligned copy of samples at an odd address, or NULL
+    int16_t *aligned;
+};
+
+// Releases the object the samples were read from
+static void release_audio_source(AudioSamples *audio) {
+#ifdef HAVE_BUFFER_PROTOCOL
+    PyBuffer_Release(&audio->view);
+#else
+    Py_DECREF(audio->bytes);
+#endif
+}
+
+// Gets the samples of any C-contiguous buffer of bytes or int16 values
+// (bytes, bytearray, memoryview, array('h'), numpy arrays, ...), in place
+// where the buffer protocol is available. Returns false with an exception
+// set on failure.
+static bool get_audio_samples(PyObject *obj, AudioSamples *audio) {
+    audio->aligned = NULL;
+    const char *data = NULL;
+#ifdef HAVE_BUFFER_PROTOCOL
+    if (PyObject_GetBuffer(obj, &audio->view,
+                           PyBUF_C_CONTIGUOUS | PyBUF_FORMAT) < 0) {
+        return false;
+    }
+    if (!is_audio_format(audio->view.format)) {
+        PyErr_Format(PyExc_TypeError,
+                     "audio must be bytes or 16-bit samples, not format '%s'",
+                     audio->view.format);
+        PyBuffer_Release(&audio->view);
+        return false;
+    }
+    data = (const char *)audio->view.buf;
+    audio->len = audio->view.len;
+#else
+    // Without the buffer protocol, only bytes can be read in place, and
+    // other buffers are checked and copied through a memoryview
+    if (PyBytes_Check(obj)) {
+        Py_INCREF(obj);
+        audio->bytes = obj;
+    } else {
+        PyObject *view = PyMemoryView_FromObject(obj);
+        if (!view)
+            return false;
+        PyObject *format = PyObject_GetAttrString(view, "format");
+        PyObject *format_bytes =
+            format ? PyUnicode_AsUTF8String(format) : NULL;
+        PyObject *contiguous = PyObject_GetAttrString(view, "c_contiguous");
+        bool ok = format_bytes && contiguous;
+        if (ok && !is_audio_format(PyBytes_AsString(format_bytes))) {
+            PyErr_Format(PyExc_TypeError,
+                         "audio must be bytes or 16-bit samples, not format "
+                         "'%U'",
+                         format);
+            ok = false;
+        } else if (ok && !PyObject_IsTrue(contiguous)) {
+            PyErr_SetString(PyExc_BufferError, "audio is not C-contiguous");
+            ok = false;
+        }
+        Py_XDECREF(contiguous);
+        Py_XDECREF(format_bytes);
+        Py_XDECREF(format);
+        audio->bytes = ok ? PyBytes_FromObject(view) : NULL;
+        Py_DECREF(view);
+        if (!audio->bytes)
+            return false;
+    }
+    data = PyBytes_AsString(audio->bytes);
+    audio->len = PyBytes_Size(audio->bytes);
+#endif
+    // Slices of a buffer can start at any byte
+    if ((uintptr_t)data % sizeof(int16_t) != 0) {
+        audio->aligned = (int16_t *)malloc(audio->len + 1);
+        if (!audio->aligned) {
+            release_audio_source(audio);
+            PyErr_NoMemory();
+            return false;
+        }
+        memcpy(audio->aligned, data, audio->len);
+        data = (const char *)audio->aligned;
+    }
+    audio->samples = (const int16_t *)data;
+    return true;
+}
+
+static void release_audio_samples(AudioSamples *audio) {
+    free(audio->aligned);
+    release_audio_source(audio);
+}
+
 // -------------------- create_frontend() --------------------
 static PyObject *mod_create_frontend(PyObject *, PyObject *) {
     auto *h = (FrontendHandle *)malloc(sizeof(FrontendHandle));
@@ -98,11 +250,10 @@ static PyObject *mod_process_samples(PyObject *, PyObject *args,
                                      PyObject *kwargs) {
     static const char *kwlist[] = {"frontend", "audio", NULL};
     PyObject *cap = NULL;
-    const char *data = nullptr;
-    Py_ssize_t len = 0;
+    PyObject *audio_obj = NULL;
 
-    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "Oy#", (char **)kwlist, &cap,
-                                     &data, &len)) {
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "OO", (char **)kwlist, &cap,
+                                     &audio_obj)) {
         return NULL;
     }
 
@@ -112,54 +263,48 @@ static PyObject *mod_process_samples(PyObject *, PyObject *args,
         return NULL;
     }
 
-    if (len < (Py_ssize_t)BYTES_PER_CHUNK) {
+    AudioSamples audio;
+    if (!get_audio_samples(audio_obj, &audio))
+        return NULL;
+
+    if (audio.len < (Py_ssize_t)BYTES_PER_CHUNK) {
         PyErr_Format(
             PyExc_ValueError,
             "audio length (%zd bytes) < required chunk size (%u bytes)",
-            (Py_ssize_t)len, (unsigned)BYTES_PER_CHUNK);
+            audio.len, (unsigned)BYTES_PER_CHUNK);
+        release_audio_samples(&audio);
         return NULL;
     }
 
-    const int16_t *samples = (const int16_t *)data;
-
     size_t samples_read = 0;
-    FrontendOutput fo;
-    Py_BEGIN_ALLOW_THREADS fo = FrontendProcessSamples(
-        &h->st, samples, SAMPLES_PER_CHUNK, &samples_read);
+    // Converted to float along with the log of the features
+    float features[PREPROCESSOR_FEATURE_SIZE];
+    size_t features_size;
+    Py_BEGIN_ALLOW_THREADS features_size = FrontendProcessSamplesToFloat(
+        &h->st, audio.samples, SAMPLES_PER_CHUNK, &samples_read,
+        FLOAT32_SCALE, features);
     Py_END_ALLOW_THREADS
 
-        PyObject *features_list = PyList_New((Py_ssize_t)fo.size);
-    if (!features_list)
-        return NULL;
+        release_audio_samples(&audio);
 
-    for (size_t i = 0; i < fo.size; ++i) {
-        double v = (double)(fo.values[i] * FLOAT32_SCALE);
-        PyObject *f = PyFloat_FromDouble(v);
-        if (!f) {
-            Py_DECREF(features_list);
-            return NULL;
-        }
-        if (PyList_SetItem(features_list, (Py_ssize_t)i, f) < 0) {
-            Py_DECREF(f);
-            Py_DECREF(features_list);
-            return NULL;
-        }
-    }
+    PyObject *features_array = new_float_array(features, features_size);
+    if (!features_array)
+        return NULL;
 
     PyObject *py_samples_read = PyLong_FromSize_t(samples_read);
     if (!py_samples_read) {
-        Py_DECREF(features_list);
+        Py_DECREF(features_array);
         return NULL;
     }
 
     PyObject *ret = PyTuple_New(2);
     if (!ret) {
         Py_DECREF(py_samples_read);
-        Py_DECREF(features_list);
+        Py_DECREF(features_array);
         return NULL;
     }
-    if (PyTuple_SetItem(ret, 0, features_list) < 0) {
-        Py_DECREF(ret); // also DECREFs features_list via failure path
+    if (PyTuple_SetItem(ret, 0, features_array) < 0) {
+        Py_DECREF(ret); // also DECREFs features_array via failure path
         Py_DECREF(py_samples_read);
         return NULL;
     }
@@ -171,6 +316,76 @@ static PyObject *mod_process_samples(PyObject *, PyObject *args,
     return ret;
 }
 
+// -------------------- process_audio(frontend, audio) --------------------
+static PyObject *mod_process_audio(PyObject *, PyObject *args,
+                                   PyObject *kwargs) {
+    static const char *kwlist[] = {"frontend", "audio", NULL};
+    PyObject *cap = NULL;
+    PyObject *audio_obj = NULL;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "OO", (char **)kwlist, &cap,
+                                     &audio_obj)) {
+        return NULL;
+    }
+
+    FrontendHandle *h = get_handle(cap);
+    if (!h)
+        return NULL;
+
+    AudioSamples audio;
+    if (!get_audio_samples(audio_obj, &audio))
+        return NULL;
+
+    const int16_t *samples = audio.samples;
+    const size_t num_samples = (size_t)audio.len / sizeof(int16_t);
+    // Every frame the samples complete, with those already buffered
+    const size_t max_frames =
+        FrontendNumFrames(&h->st, h->st.window.input_used + num_samples);
+
+    // Filled in before anyone else can see it, so without the GIL
+    PyObject *buffer = PyByteArray_FromStringAndSize(
+        NULL, (Py_ssize_t)(max_frames * PREPROCESSOR_FEATURE_SIZE *
+                           sizeof(float)));
+    if (!buffer) {
+        release_audio_samples(&audio);
+        return NULL;
+    }
+    float *features = (float *)PyByteArray_AsString(buffer);
+
+    size_t num_frames = 0;
+    Py_BEGIN_ALLOW_THREADS size_t offset = 0;
+    while (offset < num_samples) {
+        size_t samples_read = 0;
+        num_frames += FrontendProcessSamplesToFloat(
+                          &h->st, samples + offset, num_samples - offset,
+                          &samples_read, FLOAT32_SCALE,
+                          features + num_frames * PREPROCESSOR_FEATURE_SIZE) >
+                      0;
+        offset += samples_read;
+    }
+    Py_END_ALLOW_THREADS
+
+        release_audio_samples(&audio);
+    PyObject *bytes_view = PyMemoryView_FromObject(buffer);
+    Py_DECREF(buffer);
+    if (!bytes_view)
+        return NULL;
+
+    // memoryview can't have a zero in its shape, so no frames is flat
+    PyObject *features_view =
+        num_frames > 0
+            ? PyObject_CallMethod(bytes_view, "cast", "s(nn)", "f",
+                                  (Py_ssize_t)num_frames,
+                                  (Py_ssize_t)PREPROCESSOR_FEATURE_SIZE)
+            : PyObject_CallMethod(bytes_view, "cast", "s", "f");
+    Py_DECREF(bytes_view);
+    if (!features_view)
+        return NULL;
+
+    return Py_BuildValue("(Nn)", features_view,
+                         (Py_ssize_t)(num_samples * sizeof(int16_t)));
+}
+
 // -------------------- reset_frontend(frontend) --------------------
 static PyObject *mod_reset_frontend(PyObject *, PyObject *args) {
     PyObject *cap = NULL;
@@ -193,8 +408,12 @@ static PyMethodDef module_methods[] = {
      "create_frontend() -> capsule"},
     {"process_samples", (PyCFunction)mod_process_samples,
      METH_VARARGS | METH_KEYWORDS,
-     "process_samples(frontend, audio: bytes) -> (features: list[float], "
+     "process_samples(frontend, audio: Buffer) -> (features: array[float], "
      "samples_read: int)"},
+    {"process_audio", (PyCFunction)mod_process_audio,
+     METH_VARARGS | METH_KEYWORDS,
+     "process_audio(frontend, audio: Buffer) -> (features: memoryview, "
+     "bytes_read: int)"},
     {"reset_frontend", (PyCFunction)mod_reset_frontend, METH_VARARGS,
      "reset_frontend(frontend) -> None"},
     {NULL, NULL, 0, NULL}};
@@ -215,6 +434,23 @@ PyMODINIT_FUNC PyInit_micro_features_cpp(void) {
     if (!m)
         return NULL;
 
+    if (!array_type) {
+        PyObject *array_module = PyImport_ImportModule("array");
+        if (!array_module) {
+            Py_DECREF(m);
+            return NULL;
+        }
+        array_type = PyObject_GetAttrString(array_module, "array");
+        Py_DECREF(array_module);
+        float_typecode = PyUnicode_FromString("f");
+        if (!array_type || !float_typecode) {
+            Py_CLEAR(array_type);
+            Py_CLEAR(float_typecode);
+            Py_DECREF(m);
+            return NULL;
+        }
+    }
+
 #ifdef VERSION_INFO
     PyObject *ver = PyUnicode_FromString(VERSION_INFO);
 #else
@@ -43,6 +43,14 @@ static void init_cfg(struct FrontendConfig *cfg) {
 
 	cfg->log_scale.enable_log = 1;
 	cfg->log_scale.scale_shift = 6;
+
+	cfg->use_float_engine = 0;
+	cfg->incremental_fft = 0;
+	cfg->fft_backend = NULL;
+	cfg->num_heads = 0;
+	cfg->heads = NULL;
+	cfg->emit_stride = 1;
+	cfg->emit_phase = 0;
 }
 
 MicroFrontend *micro_frontend_create(void) {
@@ -78,31 +86,28 @@ int micro_frontend_process_samples(MicroFrontend *frontend,
 		return -2;  // Not enough samples
 	}
 
+	// The features are converted to float along with their log
+	float *features = (float *)malloc(PREPROCESSOR_FEATURE_SIZE * sizeof(float));
+	if (!features) {
+		return -4;  // Memory allocation failed
+	}
+
 	size_t samples_read = 0;
-	struct FrontendOutput fo = FrontendProcessSamples(&frontend->st, audio_data,
-							   SAMPLES_PER_CHUNK,
-							   &samples_read);
+	size_t features_size = FrontendProcessSamplesToFloat(
+		&frontend->st, audio_data, SAMPLES_PER_CHUNK, &samples_read,
+		FLOAT32_SCALE, features);
 
 	// If no features generated (not enough samples yet), return success with 0 features
-	if (fo.size == 0 || fo.values == NULL) {
+	if (features_size == 0) {
+		free(features);
 		output->features = NULL;
 		output->features_size = 0;
 		output->samples_read = samples_read;
 		return 0;
 	}
 
-	// Allocate and convert features to float
-	float *features = (float *)malloc(fo.size * sizeof(float));
-	if (!features) {
-		return -4;  // Memory allocation failed
-	}
-
-	for (size_t i = 0; i < fo.size; ++i) {
-		features[i] = (float)(fo.values[i] * FLOAT32_SCALE);
-	}
-
 	output->features = features;
-	output->features_size = fo.size;
+	output->features_size = features_size;
 	output->samples_read = samples_read;
 
 	return 0;
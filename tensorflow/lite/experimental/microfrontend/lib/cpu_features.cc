@@ -0,0 +1,158 @@
+/* Copyright 2026 The pymicro-features Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tensorflow/lite/experimental/microfrontend/lib/cpu_features.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <atomic>
+
+#ifdef CPU_FEATURES_X86
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+namespace {
+
+const char* const kTierNames[kCpuNumTiers] = {"scalar", "sse4.1", "avx2",
+                                              "avx512"};
+
+// -1 until the first CpuActiveTier() call.
+std::atomic<int> g_active_tier(-1);
+
+#ifdef CPU_FEATURES_X86
+void Cpuid(unsigned int leaf, unsigned int subleaf, unsigned int* regs) {
+#ifdef _MSC_VER
+  int info[4];
+  __cpuidex(info, leaf, subleaf);
+  int i;
+  for (i = 0; i < 4; ++i) {
+    regs[i] = info[i];
+  }
+#else
+  if (!__get_cpuid_count(leaf, subleaf, &regs[0], &regs[1], &regs[2],
+                         &regs[3])) {
+    regs[0] = regs[1] = regs[2] = regs[3] = 0;
+  }
+#endif
+}
+
+// The register state the operating system saves (XCR0). Only valid if
+// CPUID reports OSXSAVE.
+unsigned long long ReadXcr0() {
+#ifdef _MSC_VER
+  return _xgetbv(0);
+#else
+  unsigned int eax;
+  unsigned int edx;
+  __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+  return (static_cast<unsigned long long>(edx) << 32) | eax;
+#endif
+}
+#endif  // CPU_FEATURES_X86
+
+}  // namespace
+
+int CpuDetectTier(void) {
+#ifdef CPU_FEATURES_X86
+  unsigned int regs[4];
+  Cpuid(0, 0, regs);
+  const unsigned int max_leaf = regs[0];
+  Cpuid(1, 0, regs);
+  const unsigned int leaf1_ecx = regs[2];
+  const bool ssse3 = leaf1_ecx & (1u << 9);
+  const bool sse41 = leaf1_ecx & (1u << 19);
+  const bool osxsave = leaf1_ecx & (1u << 27);
+  const bool avx = leaf1_ecx & (1u << 28);
+  if (!ssse3 || !sse41) {
+    return kCpuTierScalar;
+  }
+  if (max_leaf < 7 || !osxsave || !avx) {
+    return kCpuTierSse41;
+  }
+  const unsigned long long xcr0 = ReadXcr0();
+  // XMM and YMM state, then the opmask and both halves of the ZMM state.
+  const unsigned long long kYmmState = 0x6;
+  const unsigned long long kZmmState = 0xE0;
+  if ((xcr0 & kYmmState) != kYmmState) {
+    return kCpuTierSse41;
+  }
+  Cpuid(7, 0, regs);
+  const unsigned int leaf7_ebx = regs[1];
+  if (!(leaf7_ebx & (1u << 5))) {
+    return kCpuTierSse41;
+  }
+  // F, DQ, CD, BW and VL.
+  const unsigned int kAvx512Bits =
+      (1u << 16) | (1u << 17) | (1u << 28) | (1u << 30) | (1u << 31);
+  if ((leaf7_ebx & kAvx512Bits) != kAvx512Bits ||
+      (xcr0 & kZmmState) != kZmmState) {
+    return kCpuTierAvx2;
+  }
+  return kCpuTierAvx512;
+#else
+  return kCpuTierScalar;
+#endif
+}
+
+int CpuActiveTier(void) {
+  int tier = g_active_tier.load(std::memory_order_relaxed);
+  if (tier >= 0) {
+    return tier;
+  }
+  tier = CpuDetectTier();
+  const char* forced = getenv(kCpuTierEnvironmentVariable);
+  if (forced != NULL && forced[0] != '\0') {
+    const int forced_tier = CpuParseTierName(forced);
+    if (forced_tier < 0) {
+      fprintf(stderr, "Unknown %s '%s'\n", kCpuTierEnvironmentVariable,
+              forced);
+    } else if (forced_tier > tier) {
+      fprintf(stderr, "%s '%s' is not supported by this CPU, using '%s'\n",
+              kCpuTierEnvironmentVariable, forced, kTierNames[tier]);
+    } else {
+      tier = forced_tier;
+    }
+  }
+  // Racing first calls all compute the same tier.
+  g_active_tier.store(tier, std::memory_order_relaxed);
+  return tier;
+}
+
+int CpuSetTier(int tier) {
+  if (tier < 0 || tier > CpuDetectTier()) {
+    return 0;
+  }
+  g_active_tier.store(tier, std::memory_order_relaxed);
+  return 1;
+}
+
+const char* CpuTierName(int tier) {
+  return (tier >= 0 && tier < kCpuNumTiers) ? kTierNames[tier] : NULL;
+}
+
+int CpuParseTierName(const char* name) {
+  int tier;
+  for (tier = 0; tier < kCpuNumTiers; ++tier) {
+    if (strcmp(name, kTierNames[tier]) == 0) {
+      return tier;
+    }
+  }
+  return -1;
+}
@@ -0,0 +1,86 @@
+/* Copyright 2026 The pymicro-features Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef TENSORFLOW_LITE_EXPERIMENTAL_MICROFRONTEND_LIB_CPU_FEATURES_H_
+#define TENSORFLOW_LITE_EXPERIMENTAL_MICROFRONTEND_LIB_CPU_FEATURES_H_
+
+// Defined if kernels for the x86 tiers above scalar are built. Each of them
+// lives in its own translation unit, compiled for its instruction set with
+// target pragmas, so the rest of the library keeps the baseline flags.
+#if (defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || \
+     defined(_M_IX86)) &&                                            \
+    (defined(__GNUC__) || defined(__clang__) || defined(_MSC_VER))
+#define CPU_FEATURES_X86
+#endif
+
+// Picks one of four kernel sets, each for the tier of the same name, by tier.
+// Without the x86 tiers only the scalar set exists, and the others are not
+// expanded, so they need no declarations there. Unknown tiers get the scalar
+// set.
+#ifdef CPU_FEATURES_X86
+#define CPU_TIER_SELECT(tier, scalar, sse41, avx2, avx512) \
+  ((tier) == kCpuTierAvx512  ? (avx512)                    \
+   : (tier) == kCpuTierAvx2  ? (avx2)                      \
+   : (tier) == kCpuTierSse41 ? (sse41)                     \
+                             : (scalar))
+#else
+#define CPU_TIER_SELECT(tier, scalar, sse41, avx2, avx512) \
+  ((void)(tier), (scalar))
+#endif
+
+// Name of the environment variable that lowers the tier kernels run with.
+#define kCpuTierEnvironmentVariable "MICRO_FEATURES_CPU_TIER"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Instruction set levels with their own kernels, lowest first. Each tier
+// includes the ones before it. Kernels for every tier give the same results.
+enum CpuTier {
+  kCpuTierScalar = 0,
+  // SSE2 through SSE4.1, including SSSE3.
+  kCpuTierSse41 = 1,
+  // AVX2, with the operating system saving the YMM registers.
+  kCpuTierAvx2 = 2,
+  // AVX-512 F, BW, DQ, CD and VL, with the ZMM registers saved.
+  kCpuTierAvx512 = 3,
+};
+#define kCpuNumTiers 4
+
+// Returns the highest tier this CPU and operating system support.
+int CpuDetectTier(void);
+
+// Returns the tier kernels run with. On first use this is the detected tier,
+// lowered to the one named by the MICRO_FEATURES_CPU_TIER environment
+// variable if that is set (tiers the CPU lacks are ignored with a warning).
+int CpuActiveTier(void);
+
+// Makes kernels run with the given tier from now on, for tests and
+// benchmarks. Returns 0 and changes nothing if the CPU does not support it.
+// Should not race with running kernels.
+int CpuSetTier(int tier);
+
+// Returns "scalar", "sse4.1", "avx2" or "avx512", the names the environment
+// variable accepts, or NULL for an unknown tier.
+const char* CpuTierName(int tier);
+
+// Returns the tier with the given name, or -1.
+int CpuParseTierName(const char* name);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif  // TENSORFLOW_LITE_EXPERIMENTAL_MICROFRONTEND_LIB_CPU_FEATURES_H_
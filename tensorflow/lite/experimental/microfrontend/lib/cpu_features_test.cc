@@ -0,0 +1,58 @@
+/* Copyright 2026 The pymicro-features Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tensorflow/lite/experimental/microfrontend/lib/cpu_features.h"
+
+#include <string.h>
+
+#include "tensorflow/lite/micro/testing/micro_test.h"
+
+TF_LITE_MICRO_TESTS_BEGIN
+
+TF_LITE_MICRO_TEST(CpuFeaturesTest_TierNamesRoundTrip) {
+  int tier;
+  for (tier = 0; tier < kCpuNumTiers; ++tier) {
+    TF_LITE_MICRO_EXPECT(CpuTierName(tier) != nullptr);
+    TF_LITE_MICRO_EXPECT_EQ(CpuParseTierName(CpuTierName(tier)), tier);
+  }
+  TF_LITE_MICRO_EXPECT(strcmp(CpuTierName(kCpuTierScalar), "scalar") == 0);
+  TF_LITE_MICRO_EXPECT(CpuTierName(kCpuNumTiers) == nullptr);
+  TF_LITE_MICRO_EXPECT(CpuTierName(-1) == nullptr);
+  TF_LITE_MICRO_EXPECT_EQ(CpuParseTierName("neon"), -1);
+  TF_LITE_MICRO_EXPECT_EQ(CpuParseTierName(""), -1);
+}
+
+TF_LITE_MICRO_TEST(CpuFeaturesTest_ActiveTierIsSupported) {
+  const int detected = CpuDetectTier();
+  TF_LITE_MICRO_EXPECT(detected >= kCpuTierScalar);
+  TF_LITE_MICRO_EXPECT(detected < kCpuNumTiers);
+  TF_LITE_MICRO_EXPECT(CpuActiveTier() <= detected);
+}
+
+TF_LITE_MICRO_TEST(CpuFeaturesTest_SetTierOnlyLowers) {
+  const int active_tier = CpuActiveTier();
+  const int detected = CpuDetectTier();
+  TF_LITE_MICRO_EXPECT(CpuSetTier(kCpuTierScalar));
+  TF_LITE_MICRO_EXPECT_EQ(CpuActiveTier(), kCpuTierScalar);
+  TF_LITE_MICRO_EXPECT(CpuSetTier(detected));
+  TF_LITE_MICRO_EXPECT_EQ(CpuActiveTier(), detected);
+  TF_LITE_MICRO_EXPECT(!CpuSetTier(-1));
+  if (detected + 1 < kCpuNumTiers) {
+    TF_LITE_MICRO_EXPECT(!CpuSetTier(detected + 1));
+    TF_LITE_MICRO_EXPECT_EQ(CpuActiveTier(), detected);
+  }
+  TF_LITE_MICRO_EXPECT(CpuSetTier(active_tier));
+}
+
+TF_LITE_MICRO_TESTS_END
@@ -16,7 +16,7 @@ limitations under the License.
 
 #include <string.h>
 
-#include "tensorflow/lite/experimental/microfrontend/lib/kiss_fft_int16.h"
+#include "tensorflow/lite/experimental/microfrontend/lib/fft_backend.h"
 
 void FftCompute(struct FftState* state, const int16_t* input,
                 int input_scale_shift) {
@@ -36,14 +36,16 @@ void FftCompute(struct FftState* state, const int16_t* input,
   }
 
   // Apply the FFT.
-  kissfft_fixed16::kiss_fftr(
-      reinterpret_cast<kissfft_fixed16::kiss_fftr_cfg>(state->scratch),
-      state->input,
-      reinterpret_cast<kissfft_fixed16::kiss_fft_cpx*>(state->output));
+  state->backend->forward(state->plan, state->input, input_size, state->output,
+                          state->output_start_index, state->output_end_index);
 }
 
 void FftInit(struct FftState* state) {
-  // All the initialization is done in FftPopulateState()
+  // FftPopulateState() builds the plan, but a memory-mapped state only names
+  // its backend and leaves it to be built here.
+  if (state->plan == nullptr) {
+    state->plan = state->backend->create_plan(state->fft_size, state->scratch);
+  }
 }
 
 void FftReset(struct FftState* state) {
@@ -27,13 +27,23 @@ struct complex_int16_t {
   int16_t imag;
 };
 
+struct FftBackend;
+
 struct FftState {
   int16_t* input;
   struct complex_int16_t* output;
   size_t fft_size;
   size_t input_size;
+  // Per-state memory of the backend's plan, if it needs any.
   void* scratch;
   size_t scratch_size;
+  // Transform implementation (see fft_backend.h) and its plan for fft_size.
+  const struct FftBackend* backend;
+  const void* plan;
+  // Output bins the caller reads. Others may be left stale by the
+  // specialized transform. FftPopulateState() selects all of them.
+  size_t output_start_index;
+  size_t output_end_index;
 };
 
 void FftCompute(struct FftState* state, const int16_t* input,
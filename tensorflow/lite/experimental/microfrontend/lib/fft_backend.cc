@@ -0,0 +1,213 @@
+/* Copyright 2026 The pymicro-features Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tensorflow/lite/experimental/microfrontend/lib/fft_backend.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "tensorflow/lite/experimental/microfrontend/lib/fft_plan_cache.h"
+#include "tensorflow/lite/experimental/microfrontend/lib/fft_pow2.h"
+#include "tensorflow/lite/experimental/microfrontend/lib/kiss_fft_int16.h"
+
+namespace {
+
+// kiss_fftr() splits the input into fft_size / 2 complex pairs.
+int KissSupports(size_t fft_size) { return fft_size > 0 && fft_size % 2 == 0; }
+
+size_t KissPlanSize(size_t fft_size) {
+  size_t plan_size = 0;
+  kissfft_fixed16::kiss_fftr_alloc(fft_size, 0, nullptr, &plan_size);
+  return plan_size;
+}
+
+const void* KissCreatePlan(size_t fft_size, void* memory) {
+  size_t plan_size = KissPlanSize(fft_size);
+  return kissfft_fixed16::kiss_fftr_alloc(fft_size, 0, memory, &plan_size);
+}
+
+void KissForward(const void* plan, const int16_t* input,
+                 size_t /*input_size*/, struct complex_int16_t* output,
+                 size_t /*start_index*/, size_t /*end_index*/) {
+  // The config holds kissfft's work buffer, so the plan is per state and not
+  // really const.
+  kissfft_fixed16::kiss_fftr(
+      reinterpret_cast<kissfft_fixed16::kiss_fftr_cfg>(
+          const_cast<void*>(plan)),
+      input, reinterpret_cast<kissfft_fixed16::kiss_fft_cpx*>(output));
+}
+
+int Pow2Supports(size_t fft_size) { return FftPow2Supported(fft_size); }
+
+size_t Pow2PlanSize(size_t /*fft_size*/) { return 0; }
+
+const void* Pow2CreatePlan(size_t fft_size, void* /*memory*/) {
+  return FftPlanCacheLookup(fft_size);
+}
+
+void Pow2Forward(const void* plan, const int16_t* input, size_t input_size,
+                 struct complex_int16_t* output, size_t start_index,
+                 size_t end_index) {
+  FftPow2ComputeBins(reinterpret_cast<const struct FftPow2Plan*>(plan), input,
+                     input_size, output, start_index, end_index);
+}
+
+const struct FftBackend* g_backends[kFftMaxBackends] = {&kFftKissBackend,
+                                                        &kFftPow2Backend};
+size_t g_num_backends = 2;
+
+uint32_t NextRandom(uint32_t* seed) {
+  *seed = *seed * 1664525u + 1013904223u;
+  return *seed >> 16;
+}
+
+// Mean time of one transform over the num_trials frames in inputs. This
+// stays with the C library's clock, so that C programs can link the library
+// without the C++ runtime.
+double TimeForward(const struct FftBackend* backend, const void* plan,
+                   const int16_t* inputs, size_t fft_size, int num_trials,
+                   struct complex_int16_t* output) {
+  struct timespec start;
+  struct timespec end;
+  timespec_get(&start, TIME_UTC);
+  int trial;
+  for (trial = 0; trial < num_trials; ++trial) {
+    backend->forward(plan, inputs + trial * fft_size, fft_size, output, 0,
+                     fft_size / 2 + 1);
+  }
+  timespec_get(&end, TIME_UTC);
+  const double elapsed = (end.tv_sec - start.tv_sec) * 1e9 +
+                         (end.tv_nsec - start.tv_nsec);
+  return elapsed / num_trials;
+}
+
+}  // namespace
+
+const struct FftBackend kFftKissBackend = {
+    "kissfft", KissSupports, KissPlanSize, KissCreatePlan, KissForward};
+
+const struct FftBackend kFftPow2Backend = {
+    "pow2", Pow2Supports, Pow2PlanSize, Pow2CreatePlan, Pow2Forward};
+
+int FftRegisterBackend(const struct FftBackend* backend) {
+  if (FftFindBackend(backend->name) != NULL) {
+    fprintf(stderr, "FFT backend '%s' is already registered\n",
+            backend->name);
+    return 0;
+  }
+  if (g_num_backends == kFftMaxBackends) {
+    fprintf(stderr, "Too many FFT backends\n");
+    return 0;
+  }
+  g_backends[g_num_backends++] = backend;
+  return 1;
+}
+
+const struct FftBackend* FftFindBackend(const char* name) {
+  size_t i;
+  for (i = 0; i < g_num_backends; ++i) {
+    if (strcmp(g_backends[i]->name, name) == 0) {
+      return g_backends[i];
+    }
+  }
+  return NULL;
+}
+
+size_t FftNumBackends(void) { return g_num_backends; }
+
+const struct FftBackend* FftGetBackend(size_t index) {
+  return index < g_num_backends ? g_backends[index] : NULL;
+}
+
+const struct FftBackend* FftDefaultBackend(size_t fft_size) {
+  size_t i = g_num_backends;
+  while (i-- > 0) {
+    if (g_backends[i]->supports(fft_size)) {
+      return g_backends[i];
+    }
+  }
+  return NULL;
+}
+
+int FftBackendCheck(const struct FftBackend* backend, size_t fft_size,
+                    int num_trials, struct FftBackendReport* report) {
+  memset(report, 0, sizeof(*report));
+  const size_t num_bins = fft_size / 2 + 1;
+  void* memory = malloc(backend->plan_size(fft_size));
+  void* reference_memory = malloc(kFftKissBackend.plan_size(fft_size));
+  int16_t* inputs = reinterpret_cast<int16_t*>(
+      malloc(num_trials * fft_size * sizeof(*inputs)));
+  struct complex_int16_t* output = reinterpret_cast<struct complex_int16_t*>(
+      malloc(num_bins * sizeof(*output)));
+  struct complex_int16_t* expected = reinterpret_cast<struct complex_int16_t*>(
+      malloc(num_bins * sizeof(*expected)));
+  int ok = 0;
+  if (memory == NULL && backend->plan_size(fft_size) > 0) {
+    fprintf(stderr, "Failed to alloc fft plan memory\n");
+  } else if (reference_memory == NULL || inputs == NULL || output == NULL ||
+             expected == NULL) {
+    fprintf(stderr, "Failed to alloc fft check buffers\n");
+  } else {
+    const void* reference_plan =
+        kFftKissBackend.create_plan(fft_size, reference_memory);
+    const void* plan = backend->create_plan(fft_size, memory);
+    if (reference_plan == NULL) {
+      fprintf(stderr, "No reference fft for size %zu\n", fft_size);
+    } else {
+      ok = 1;
+    }
+    if (ok && plan != NULL) {
+      report->supported = 1;
+      // Full-scale noise, as FftCompute() sees after the input shift.
+      uint32_t seed = 1;
+      size_t i;
+      for (i = 0; i < num_trials * fft_size; ++i) {
+        inputs[i] = static_cast<int16_t>(NextRandom(&seed));
+      }
+      int trial;
+      for (trial = 0; trial < num_trials; ++trial) {
+        const int16_t* input = inputs + trial * fft_size;
+        kFftKissBackend.forward(reference_plan, input, fft_size, expected, 0,
+                                num_bins);
+        backend->forward(plan, input, fft_size, output, 0, num_bins);
+        for (i = 0; i < num_bins; ++i) {
+          const int errors[2] = {output[i].real - expected[i].real,
+                                 output[i].imag - expected[i].imag};
+          int j;
+          for (j = 0; j < 2; ++j) {
+            const int error = errors[j] < 0 ? -errors[j] : errors[j];
+            if (error > 0) {
+              ++report->num_mismatches;
+            }
+            if (error > report->max_error) {
+              report->max_error = error;
+            }
+          }
+        }
+      }
+      report->nanoseconds =
+          TimeForward(backend, plan, inputs, fft_size, num_trials, output);
+      report->reference_nanoseconds = TimeForward(
+          &kFftKissBackend, reference_plan, inputs, fft_size, num_trials,
+          expected);
+    }
+  }
+  free(memory);
+  free(reference_memory);
+  free(inputs);
+  free(output);
+  free(expected);
+  return ok;
+}
@@ -0,0 +1,103 @@
+/* Copyright 2026 The pymicro-features Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef TENSORFLOW_LITE_EXPERIMENTAL_MICROFRONTEND_LIB_FFT_BACKEND_H_
+#define TENSORFLOW_LITE_EXPERIMENTAL_MICROFRONTEND_LIB_FFT_BACKEND_H_
+
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "tensorflow/lite/experimental/microfrontend/lib/fft.h"
+
+// Most backends the registry holds, built-in ones included.
+#define kFftMaxBackends 8
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// A fixed-point forward real FFT implementation. Its output must be on the
+// same scale as kissfft_fixed16::kiss_fftr, which is the reference every
+// backend is checked against (see FftBackendCheck()).
+struct FftBackend {
+  // Unique name, used to select the backend in FftPopulateStateWithBackend()
+  // and FrontendConfig.
+  const char* name;
+  // Returns non-zero if the backend has a transform for fft_size. This must
+  // be cheap, as it is asked of each backend when a state does not name one.
+  int (*supports)(size_t fft_size);
+  // Bytes of per-state memory a plan for fft_size needs. May be 0, for
+  // example if the plan is shared between states.
+  size_t (*plan_size)(size_t fft_size);
+  // Builds the plan for fft_size in memory, which holds plan_size(fft_size)
+  // bytes. Returns NULL if the backend does not support fft_size or the plan
+  // could not be built.
+  const void* (*create_plan)(size_t fft_size, void* memory);
+  // Computes the fft_size / 2 + 1 outputs of the transform of the fft_size
+  // samples of input. Samples from input_size on are zero, and only output
+  // bins [start_index, end_index) have to be filled in.
+  void (*forward)(const void* plan, const int16_t* input, size_t input_size,
+                  struct complex_int16_t* output, size_t start_index,
+                  size_t end_index);
+};
+
+// kissfft_fixed16, for any even size.
+extern const struct FftBackend kFftKissBackend;
+// The specialized power-of-two transform (fft_pow2.h), with plans shared
+// through the plan cache. Bit-exact with kissfft.
+extern const struct FftBackend kFftPow2Backend;
+
+// Adds a backend to the registry. Backends registered later take precedence
+// when a state does not name one. Returns 0 if the name is already taken or
+// the registry is full. Registration is not thread-safe, so it should happen
+// before any states are populated.
+int FftRegisterBackend(const struct FftBackend* backend);
+
+// Returns the registered backend with the given name, or NULL.
+const struct FftBackend* FftFindBackend(const char* name);
+
+// Returns the number of registered backends, and the one at index, in order
+// of registration. The built-in backends come first.
+size_t FftNumBackends(void);
+const struct FftBackend* FftGetBackend(size_t index);
+
+// Returns the most recently registered backend that supports fft_size. This
+// is what FftPopulateState() uses.
+const struct FftBackend* FftDefaultBackend(size_t fft_size);
+
+// Result of checking a backend against kissfft on random input.
+struct FftBackendReport {
+  // Zero if the backend has no plan for the size. The other fields are only
+  // set if it does.
+  int supported;
+  // Largest absolute difference from kissfft over every real and imaginary
+  // output part, and how many parts differed at all.
+  int max_error;
+  size_t num_mismatches;
+  // Mean time of one forward transform, and the same for kissfft.
+  double nanoseconds;
+  double reference_nanoseconds;
+};
+
+// Runs the backend and kissfft on num_trials frames of random input of
+// fft_size samples, and compares and times them. Returns 0 if buffers could
+// not be allocated or kissfft does not support fft_size.
+int FftBackendCheck(const struct FftBackend* backend, size_t fft_size,
+                    int num_trials, struct FftBackendReport* report);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif  // TENSORFLOW_LITE_EXPERIMENTAL_MICROFRONTEND_LIB_FFT_BACKEND_H_
@@ -0,0 +1,58 @@
+/* Copyright 2026 The pymicro-features Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "tensorflow/lite/experimental/microfrontend/lib/fft_backend.h"
+
+// Checks every registered FFT backend against kissfft and times it. Takes an
+// optional list of transform sizes, 64 to 4096 by default. Exits with a
+// non-zero status if any backend differs from kissfft.
+int main(int argc, char** argv) {
+  const int num_trials = 2000;
+  const size_t default_sizes[] = {64, 128, 256, 512, 1024, 2048, 4096};
+  const size_t num_default_sizes =
+      sizeof(default_sizes) / sizeof(default_sizes[0]);
+  const size_t num_sizes = argc > 1 ? argc - 1 : num_default_sizes;
+
+  int status = 0;
+  printf("%-12s %6s %10s %10s %8s %10s\n", "backend", "size", "mismatches",
+         "max_error", "ns", "kissfft_ns");
+  size_t s;
+  for (s = 0; s < num_sizes; ++s) {
+    const size_t fft_size =
+        argc > 1 ? strtoul(argv[s + 1], NULL, 10) : default_sizes[s];
+    size_t b;
+    for (b = 0; b < FftNumBackends(); ++b) {
+      const struct FftBackend* backend = FftGetBackend(b);
+      struct FftBackendReport report;
+      if (!FftBackendCheck(backend, fft_size, num_trials, &report)) {
+        fprintf(stderr, "Failed to check size %zu\n", fft_size);
+        return 1;
+      }
+      if (!report.supported) {
+        printf("%-12s %6zu %10s\n", backend->name, fft_size, "-");
+        continue;
+      }
+      printf("%-12s %6zu %10zu %10d %8.0f %10.0f\n", backend->name, fft_size,
+             report.num_mismatches, report.max_error, report.nanoseconds,
+             report.reference_nanoseconds);
+      if (report.num_mismatches > 0) {
+        status = 1;
+      }
+    }
+  }
+  return status;
+}
@@ -0,0 +1,130 @@
+/* Copyright 2026 The pymicro-features Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tensorflow/lite/experimental/microfrontend/lib/fft_backend.h"
+
+#include "tensorflow/lite/experimental/microfrontend/lib/fft_util.h"
+#include "tensorflow/lite/micro/testing/micro_test.h"
+
+namespace {
+
+const int kNumTrials = 8;
+
+int g_num_create_plan_calls = 0;
+int g_num_forward_calls = 0;
+
+// Only 512 is supported, so other sizes fall back to the built-ins.
+int CountingSupports(size_t fft_size) { return fft_size == 512; }
+
+size_t CountingPlanSize(size_t fft_size) {
+  return kFftPow2Backend.plan_size(fft_size);
+}
+
+const void* CountingCreatePlan(size_t fft_size, void* memory) {
+  ++g_num_create_plan_calls;
+  return CountingSupports(fft_size)
+             ? kFftPow2Backend.create_plan(fft_size, memory)
+             : nullptr;
+}
+
+void CountingForward(const void* plan, const int16_t* input, size_t input_size,
+                     struct complex_int16_t* output, size_t start_index,
+                     size_t end_index) {
+  ++g_num_forward_calls;
+  kFftPow2Backend.forward(plan, input, input_size, output, start_index,
+                          end_index);
+}
+
+const struct FftBackend kCountingBackend = {"counting", CountingSupports,
+                                            CountingPlanSize,
+                                            CountingCreatePlan,
+                                            CountingForward};
+
+}  // namespace
+
+TF_LITE_MICRO_TESTS_BEGIN
+
+TF_LITE_MICRO_TEST(FftBackendTest_BuiltinsMatchKissfft) {
+  TF_LITE_MICRO_EXPECT_EQ(FftNumBackends(), static_cast<size_t>(2));
+  const size_t sizes[] = {4, 64, 256, 512, 4096, 8192};
+  size_t b;
+  for (b = 0; b < FftNumBackends(); ++b) {
+    const struct FftBackend* backend = FftGetBackend(b);
+    size_t s;
+    for (s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s) {
+      struct FftBackendReport report;
+      TF_LITE_MICRO_EXPECT(
+          FftBackendCheck(backend, sizes[s], kNumTrials, &report));
+      // The power-of-two kernels stop at 4096.
+      TF_LITE_MICRO_EXPECT_EQ(report.supported,
+                              backend == &kFftKissBackend || sizes[s] <= 4096);
+      TF_LITE_MICRO_EXPECT_EQ(report.num_mismatches, static_cast<size_t>(0));
+      TF_LITE_MICRO_EXPECT_EQ(report.max_error, 0);
+    }
+  }
+}
+
+TF_LITE_MICRO_TEST(FftBackendTest_SelectsBackendByName) {
+  struct FftState state;
+  TF_LITE_MICRO_EXPECT(FftPopulateStateWithBackend(&state, 480, "kissfft"));
+  TF_LITE_MICRO_EXPECT(state.backend == &kFftKissBackend);
+  TF_LITE_MICRO_EXPECT(state.scratch_size > 0);
+  FftFreeStateContents(&state);
+
+  TF_LITE_MICRO_EXPECT(FftPopulateState(&state, 480));
+  TF_LITE_MICRO_EXPECT(state.backend == &kFftPow2Backend);
+  FftFreeStateContents(&state);
+
+  TF_LITE_MICRO_EXPECT(!FftPopulateStateWithBackend(&state, 480, "missing"));
+  FftFreeStateContents(&state);
+  // No power-of-two kernel for 8192.
+  TF_LITE_MICRO_EXPECT(!FftPopulateStateWithBackend(&state, 8000, "pow2"));
+  FftFreeStateContents(&state);
+  TF_LITE_MICRO_EXPECT(FftPopulateState(&state, 8000));
+  TF_LITE_MICRO_EXPECT(state.backend == &kFftKissBackend);
+  FftFreeStateContents(&state);
+}
+
+TF_LITE_MICRO_TEST(FftBackendTest_RegisteredBackendIsPreferred) {
+  TF_LITE_MICRO_EXPECT(FftRegisterBackend(&kCountingBackend));
+  TF_LITE_MICRO_EXPECT(!FftRegisterBackend(&kCountingBackend));
+  TF_LITE_MICRO_EXPECT(FftFindBackend("counting") == &kCountingBackend);
+
+  struct FftBackendReport report;
+  TF_LITE_MICRO_EXPECT(
+      FftBackendCheck(&kCountingBackend, 512, kNumTrials, &report));
+  TF_LITE_MICRO_EXPECT(report.supported);
+  TF_LITE_MICRO_EXPECT_EQ(report.num_mismatches, static_cast<size_t>(0));
+
+  // Picking the backend does not build a plan of its own.
+  struct FftState state;
+  g_num_create_plan_calls = 0;
+  TF_LITE_MICRO_EXPECT(FftPopulateState(&state, 480));
+  TF_LITE_MICRO_EXPECT(state.backend == &kCountingBackend);
+  TF_LITE_MICRO_EXPECT_EQ(g_num_create_plan_calls, 1);
+  const int16_t input[480] = {1000, -1000};
+  g_num_forward_calls = 0;
+  FftCompute(&state, input, 0);
+  TF_LITE_MICRO_EXPECT_EQ(g_num_forward_calls, 1);
+  FftFreeStateContents(&state);
+
+  // Sizes it does not support still get a built-in.
+  g_num_create_plan_calls = 0;
+  TF_LITE_MICRO_EXPECT(FftPopulateState(&state, 256));
+  TF_LITE_MICRO_EXPECT(state.backend == &kFftPow2Backend);
+  TF_LITE_MICRO_EXPECT_EQ(g_num_create_plan_calls, 0);
+  FftFreeStateContents(&state);
+}
+
+TF_LITE_MICRO_TESTS_END
@@ -14,11 +14,17 @@ limitations under the License.
 ==============================================================================*/
 #include "tensorflow/lite/experimental/microfrontend/lib/fft_io.h"
 
+#include "tensorflow/lite/experimental/microfrontend/lib/fft_backend.h"
+
 void FftWriteMemmapPreamble(FILE* fp, const struct FftState* state) {
+  fprintf(fp, "#include \"fft_backend.h\"\n");
   fprintf(fp, "static int16_t fft_input[%zu];\n", state->fft_size);
   fprintf(fp, "static struct complex_int16_t fft_output[%zu];\n",
           state->fft_size / 2 + 1);
-  fprintf(fp, "static char fft_scratch[%zu];\n", state->scratch_size);
+  // Backends with shared plans need no per-state memory.
+  if (state->scratch_size > 0) {
+    fprintf(fp, "static char fft_scratch[%zu];\n", state->scratch_size);
+  }
   fprintf(fp, "\n");
 }
 
@@ -28,6 +34,18 @@ void FftWriteMemmap(FILE* fp, const struct FftState* state,
   fprintf(fp, "%s->output = fft_output;\n", variable);
   fprintf(fp, "%s->fft_size = %zu;\n", variable, state->fft_size);
   fprintf(fp, "%s->input_size = %zu;\n", variable, state->input_size);
-  fprintf(fp, "%s->scratch = fft_scratch;\n", variable);
+  if (state->scratch_size > 0) {
+    fprintf(fp, "%s->scratch = fft_scratch;\n", variable);
+  } else {
+    fprintf(fp, "%s->scratch = NULL;\n", variable);
+  }
   fprintf(fp, "%s->scratch_size = %zu;\n", variable, state->scratch_size);
+  // FftInit() builds the plan.
+  fprintf(fp, "%s->backend = FftFindBackend(\"%s\");\n", variable,
+          state->backend->name);
+  fprintf(fp, "%s->plan = NULL;\n", variable);
+  fprintf(fp, "%s->output_start_index = %zu;\n", variable,
+          state->output_start_index);
+  fprintf(fp, "%s->output_end_index = %zu;\n", variable,
+          state->output_end_index);
 }
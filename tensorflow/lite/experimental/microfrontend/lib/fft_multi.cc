@@ -0,0 +1,101 @@
+/* Copyright 2026 The pymicro-features Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tensorflow/lite/experimental/microfrontend/lib/fft_multi.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include "tensorflow/lite/experimental/microfrontend/lib/cpu_features.h"
+#include "tensorflow/lite/experimental/microfrontend/lib/fft_plan_cache.h"
+#include "tensorflow/lite/experimental/microfrontend/lib/fft_pow2_dispatch.h"
+
+namespace {
+
+// The scaling and zero padding at the start of FftCompute().
+void ScaleInput(struct FftState* state, const int16_t* input,
+                int input_scale_shift) {
+  int16_t* fft_input = state->input;
+  size_t i;
+  for (i = 0; i < state->input_size; ++i) {
+    fft_input[i] = static_cast<int16_t>(static_cast<uint16_t>(input[i])
+                                        << input_scale_shift);
+  }
+  for (; i < state->fft_size; ++i) {
+    fft_input[i] = 0;
+  }
+}
+
+}  // namespace
+
+int FftMultiNumLanes(void) {
+  return FftPow2KernelsForTier(CpuActiveTier())->num_lanes;
+}
+
+int FftMultiPopulateState(struct FftMultiState* state, size_t fft_size) {
+  memset(state, 0, sizeof(*state));
+  state->fft_size = fft_size;
+  state->kernels = FftPow2KernelsForTier(CpuActiveTier());
+  state->num_lanes = state->kernels->num_lanes;
+  const int num_lanes = state->num_lanes;
+  state->plan = FftPlanCacheLookup(fft_size);
+  if (state->plan == nullptr) {
+    fprintf(stderr, "No multi-stream fft plan for size %zu\n", fft_size);
+    return 0;
+  }
+
+  state->input = reinterpret_cast<int16_t*>(
+      malloc(fft_size * num_lanes * sizeof(*state->input)));
+  if (state->input == nullptr) {
+    fprintf(stderr, "Failed to alloc multi-stream fft input buffer\n");
+    return 0;
+  }
+  state->work = reinterpret_cast<int16_t*>(
+      malloc((fft_size / 2 + 1) * 2 * num_lanes * sizeof(*state->work)));
+  if (state->work == nullptr) {
+    fprintf(stderr, "Failed to alloc multi-stream fft work buffer\n");
+    return 0;
+  }
+  return 1;
+}
+
+void FftMultiCompute(struct FftMultiState* state,
+                     struct FftState* const* states,
+                     const int16_t* const* inputs,
+                     const int* input_scale_shifts, int num_streams) {
+  const int num_lanes = state->num_lanes;
+  int first;
+  for (first = 0; first < num_streams; first += num_lanes) {
+    const int batch_size =
+        (num_streams - first < num_lanes) ? num_streams - first : num_lanes;
+    int i;
+    for (i = 0; i < batch_size; ++i) {
+      ScaleInput(states[first + i], inputs[first + i],
+                 input_scale_shifts[first + i]);
+    }
+    if (state->kernels->compute_lanes != nullptr) {
+      state->kernels->compute_lanes(state, states + first, batch_size);
+    } else {
+      for (i = 0; i < batch_size; ++i) {
+        FftPow2Compute(state->plan, states[first + i]->input,
+                       states[first + i]->output);
+      }
+    }
+  }
+}
+
+void FftMultiFreeStateContents(struct FftMultiState* state) {
+  free(state->input);
+  free(state->work);
+}
@@ -0,0 +1,73 @@
+/* Copyright 2026 The pymicro-features Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef TENSORFLOW_LITE_EXPERIMENTAL_MICROFRONTEND_LIB_FFT_MULTI_H_
+#define TENSORFLOW_LITE_EXPERIMENTAL_MICROFRONTEND_LIB_FFT_MULTI_H_
+
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "tensorflow/lite/experimental/microfrontend/lib/fft.h"
+#include "tensorflow/lite/experimental/microfrontend/lib/fft_pow2.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct FftPow2KernelSet;
+
+// Runs the FFT of several independent streams in lockstep, one stream per
+// SIMD lane (8 with SSE4.1, 16 with AVX2 and AVX-512), so the twiddle loads
+// and the loop control are shared by all of them. Each stream keeps its own
+// FftState; the frames are gathered from and scattered back to those states,
+// and the results are bit-identical to calling FftCompute() on each state.
+struct FftMultiState {
+  size_t fft_size;
+  // Kernels of the CPU tier active when the state was populated.
+  const struct FftPow2KernelSet* kernels;
+  // Streams transformed per call, 1 without SIMD kernels.
+  int num_lanes;
+  // Shared plan from the plan cache.
+  const struct FftPow2Plan* plan;
+  // Scaled input samples, sample-major: num_lanes values per sample.
+  int16_t* input;
+  // The complex transform, one block of num_lanes real parts and num_lanes
+  // imaginary parts per bin.
+  int16_t* work;
+};
+
+// Number of streams one FftMultiCompute() call transforms at once with the
+// active CPU tier.
+int FftMultiNumLanes(void);
+
+// Prepares a multi-stream FFT for states created by FftPopulateState() with
+// any input size that rounds up to fft_size. Only power-of-two sizes with a
+// specialized kernel (see fft_pow2.h) are supported.
+int FftMultiPopulateState(struct FftMultiState* state, size_t fft_size);
+
+// Same as calling FftCompute(states[i], inputs[i], input_scale_shifts[i]) for
+// each of the num_streams streams, which are taken num_lanes at a time.
+void FftMultiCompute(struct FftMultiState* state,
+                     struct FftState* const* states,
+                     const int16_t* const* inputs,
+                     const int* input_scale_shifts, int num_streams);
+
+// Frees any allocated buffers.
+void FftMultiFreeStateContents(struct FftMultiState* state);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif  // TENSORFLOW_LITE_EXPERIMENTAL_MICROFRONTEND_LIB_FFT_MULTI_H_
@@ -0,0 +1,114 @@
+/* Copyright 2026 The pymicro-features Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tensorflow/lite/experimental/microfrontend/lib/fft_multi.h"
+
+#include "tensorflow/lite/experimental/microfrontend/lib/cpu_features.h"
+#include "tensorflow/lite/experimental/microfrontend/lib/fft_util.h"
+#include "tensorflow/lite/micro/testing/micro_test.h"
+
+namespace {
+
+const int kMaxStreams = 40;
+
+uint32_t NextRandom(uint32_t* seed) {
+  *seed = *seed * 1664525u + 1013904223u;
+  return *seed >> 16;
+}
+
+}  // namespace
+
+TF_LITE_MICRO_TESTS_BEGIN
+
+TF_LITE_MICRO_TEST(FftMultiTest_MatchesFftCompute) {
+  const int active_tier = CpuActiveTier();
+  uint32_t seed = 7;
+  // The lane kernels of every tier this CPU supports.
+  int tier;
+  for (tier = 0; tier <= CpuDetectTier(); ++tier) {
+    TF_LITE_MICRO_EXPECT(CpuSetTier(tier));
+    const int num_lanes = FftMultiNumLanes();
+    const int stream_counts[] = {1, num_lanes - 1, num_lanes,
+                                 2 * num_lanes + 3};
+
+    int log2_size;
+    for (log2_size = kFftPow2MinLog2Size; log2_size <= kFftPow2MaxLog2Size;
+         ++log2_size) {
+      const size_t fft_size = (size_t)1 << log2_size;
+      struct FftMultiState multi;
+      TF_LITE_MICRO_EXPECT(FftMultiPopulateState(&multi, fft_size));
+      TF_LITE_MICRO_EXPECT_EQ(multi.num_lanes, num_lanes);
+
+      unsigned c;
+      for (c = 0; c < sizeof(stream_counts) / sizeof(stream_counts[0]); ++c) {
+        const int num_streams = stream_counts[c];
+        if (num_streams < 1 || num_streams > kMaxStreams) {
+          continue;
+        }
+        struct FftState states[kMaxStreams];
+        struct FftState expected[kMaxStreams];
+        struct FftState* state_ptrs[kMaxStreams];
+        int16_t* inputs[kMaxStreams];
+        int shifts[kMaxStreams];
+        int s;
+        for (s = 0; s < num_streams; ++s) {
+          // Streams may use any input size that pads up to the same fft_size.
+          const size_t input_size =
+              fft_size - (NextRandom(&seed) % (fft_size / 4 + 1));
+          TF_LITE_MICRO_EXPECT(FftPopulateState(&states[s], input_size));
+          TF_LITE_MICRO_EXPECT(FftPopulateState(&expected[s], input_size));
+          state_ptrs[s] = &states[s];
+          shifts[s] = NextRandom(&seed) % 4;
+          inputs[s] = reinterpret_cast<int16_t*>(malloc(input_size * 2));
+          size_t i;
+          for (i = 0; i < input_size; ++i) {
+            inputs[s][i] =
+                (s % 3 == 0)
+                    ? static_cast<int16_t>(NextRandom(&seed))
+                    : static_cast<int16_t>(NextRandom(&seed) % 2001) - 1000;
+          }
+          FftCompute(&expected[s], inputs[s], shifts[s]);
+        }
+
+        FftMultiCompute(&multi, state_ptrs, inputs, shifts, num_streams);
+
+        for (s = 0; s < num_streams; ++s) {
+          size_t i;
+          for (i = 0; i < fft_size; ++i) {
+            TF_LITE_MICRO_EXPECT_EQ(states[s].input[i], expected[s].input[i]);
+          }
+          for (i = 0; i <= fft_size / 2; ++i) {
+            TF_LITE_MICRO_EXPECT_EQ(states[s].output[i].real,
+                                    expected[s].output[i].real);
+            TF_LITE_MICRO_EXPECT_EQ(states[s].output[i].imag,
+                                    expected[s].output[i].imag);
+          }
+          free(inputs[s]);
+          FftFreeStateContents(&states[s]);
+          FftFreeStateContents(&expected[s]);
+        }
+      }
+      FftMultiFreeStateContents(&multi);
+    }
+  }
+  CpuSetTier(active_tier);
+}
+
+TF_LITE_MICRO_TEST(FftMultiTest_RejectsUnsupportedSize) {
+  struct FftMultiState multi;
+  TF_LITE_MICRO_EXPECT(!FftMultiPopulateState(&multi, 480));
+  FftMultiFreeStateContents(&multi);
+}
+
+TF_LITE_MICRO_TESTS_END
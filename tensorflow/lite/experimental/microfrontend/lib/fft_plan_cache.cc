@@ -0,0 +1,68 @@
+/* Copyright 2026 The pymicro-features Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tensorflow/lite/experimental/microfrontend/lib/fft_plan_cache.h"
+
+#include <stdio.h>
+
+#include <atomic>
+
+namespace {
+
+// Only power-of-two sizes have plans, so log2(size) indexes the table
+// directly and no two sizes share a slot.
+const int kNumSlots = kFftPow2MaxLog2Size + 1;
+
+// Zero-initialized before any dynamic initialization runs.
+std::atomic<const struct FftPow2Plan*> g_plans[kNumSlots];
+
+}  // namespace
+
+const struct FftPow2Plan* FftPlanCacheLookup(size_t fft_size) {
+  if (!FftPow2Supported(fft_size)) {
+    return NULL;
+  }
+  int log2_size = 0;
+  while (((size_t)1 << log2_size) < fft_size) {
+    ++log2_size;
+  }
+  std::atomic<const struct FftPow2Plan*>* slot = &g_plans[log2_size];
+
+  const struct FftPow2Plan* plan = slot->load(std::memory_order_acquire);
+  if (plan != NULL) {
+    return plan;
+  }
+
+  struct FftPow2Plan* created =
+      reinterpret_cast<struct FftPow2Plan*>(malloc(sizeof(*created)));
+  if (created == NULL) {
+    fprintf(stderr, "Failed to alloc fft plan\n");
+    return NULL;
+  }
+  if (!FftPow2PopulatePlan(created, fft_size)) {
+    fprintf(stderr, "Failed to populate fft plan\n");
+    FftPow2FreePlanContents(created);
+    free(created);
+    return NULL;
+  }
+  // Racing threads may each build a plan; the first one published wins and
+  // the others are dropped.
+  if (!slot->compare_exchange_strong(plan, created, std::memory_order_acq_rel,
+                                     std::memory_order_acquire)) {
+    FftPow2FreePlanContents(created);
+    free(created);
+    return plan;
+  }
+  return created;
+}
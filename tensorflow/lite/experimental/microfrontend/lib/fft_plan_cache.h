@@ -0,0 +1,40 @@
+/* Copyright 2026 The pymicro-features Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef TENSORFLOW_LITE_EXPERIMENTAL_MICROFRONTEND_LIB_FFT_PLAN_CACHE_H_
+#define TENSORFLOW_LITE_EXPERIMENTAL_MICROFRONTEND_LIB_FFT_PLAN_CACHE_H_
+
+#include <stdlib.h>
+
+#include "tensorflow/lite/experimental/microfrontend/lib/fft_pow2.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Process-wide cache of the read-only fixed-point forward real FFT plans,
+// keyed by transform size. The first lookup of a size builds its plan; later
+// lookups are a single atomic load, so creating an FftState does not
+// recompute any twiddles. Lookups are safe from any thread, and plans stay
+// alive until the process exits.
+//
+// Returns NULL if the size has no specialized kernel or if building its plan
+// failed.
+const struct FftPow2Plan* FftPlanCacheLookup(size_t fft_size);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif  // TENSORFLOW_LITE_EXPERIMENTAL_MICROFRONTEND_LIB_FFT_PLAN_CACHE_H_
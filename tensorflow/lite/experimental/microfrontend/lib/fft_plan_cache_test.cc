@@ -0,0 +1,80 @@
+/* Copyright 2026 The pymicro-features Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tensorflow/lite/experimental/microfrontend/lib/fft_plan_cache.h"
+
+#include <thread>
+
+#include "tensorflow/lite/experimental/microfrontend/lib/fft_util.h"
+#include "tensorflow/lite/micro/testing/micro_test.h"
+
+namespace {
+
+const int kNumThreads = 4;
+
+}  // namespace
+
+TF_LITE_MICRO_TESTS_BEGIN
+
+TF_LITE_MICRO_TEST(FftPlanCacheTest_ConcurrentLookupsAgree) {
+  // Runs first so that the threads race to build a plan that is not cached.
+  const size_t fft_size = (size_t)1 << kFftPow2MaxLog2Size;
+  const struct FftPow2Plan* plans[kNumThreads];
+  std::thread threads[kNumThreads];
+  int i;
+  for (i = 0; i < kNumThreads; ++i) {
+    threads[i] = std::thread(
+        [fft_size, &plans, i]() { plans[i] = FftPlanCacheLookup(fft_size); });
+  }
+  for (i = 0; i < kNumThreads; ++i) {
+    threads[i].join();
+  }
+  for (i = 0; i < kNumThreads; ++i) {
+    TF_LITE_MICRO_EXPECT(plans[i] != nullptr);
+    TF_LITE_MICRO_EXPECT(plans[i] == plans[0]);
+  }
+}
+
+TF_LITE_MICRO_TEST(FftPlanCacheTest_ReturnsSamePlan) {
+  int log2_size;
+  for (log2_size = kFftPow2MinLog2Size; log2_size <= kFftPow2MaxLog2Size;
+       ++log2_size) {
+    const size_t fft_size = (size_t)1 << log2_size;
+    const struct FftPow2Plan* plan = FftPlanCacheLookup(fft_size);
+    TF_LITE_MICRO_EXPECT(plan != nullptr);
+    TF_LITE_MICRO_EXPECT_EQ(plan->log2_size, log2_size);
+    TF_LITE_MICRO_EXPECT(FftPlanCacheLookup(fft_size) == plan);
+  }
+}
+
+TF_LITE_MICRO_TEST(FftPlanCacheTest_NoPlanForUnsupportedSizes) {
+  TF_LITE_MICRO_EXPECT(FftPlanCacheLookup(480) == nullptr);
+  TF_LITE_MICRO_EXPECT(
+      FftPlanCacheLookup((size_t)1 << (kFftPow2MaxLog2Size + 1)) == nullptr);
+}
+
+TF_LITE_MICRO_TEST(FftPlanCacheTest_StatesSharePlan) {
+  struct FftState first;
+  struct FftState second;
+  TF_LITE_MICRO_EXPECT(FftPopulateState(&first, 480));
+  TF_LITE_MICRO_EXPECT(FftPopulateState(&second, 400));
+  TF_LITE_MICRO_EXPECT(first.plan != nullptr);
+  TF_LITE_MICRO_EXPECT(first.plan == second.plan);
+  TF_LITE_MICRO_EXPECT(first.scratch == nullptr);
+  TF_LITE_MICRO_EXPECT_EQ(first.scratch_size, static_cast<size_t>(0));
+  FftFreeStateContents(&first);
+  FftFreeStateContents(&second);
+}
+
+TF_LITE_MICRO_TESTS_END
@@ -0,0 +1,180 @@
+/* Copyright 2026 The pymicro-features Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tensorflow/lite/experimental/microfrontend/lib/fft_pow2.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "tensorflow/lite/experimental/microfrontend/lib/cpu_features.h"
+#include "tensorflow/lite/experimental/microfrontend/lib/fft_pow2_dispatch.h"
+
+// The scalar kernels. Those for the other tiers are built from the same
+// header in fft_pow2_<tier>.cc.
+#include "tensorflow/lite/experimental/microfrontend/lib/fft_pow2_compute.h"
+
+namespace {
+
+using fft_pow2::kSampMax;
+
+// kf_cexp() as used by kiss_fft_alloc(), so the tables match kissfft's.
+struct complex_int16_t KissTwiddle(int i, int nfft) {
+  const double pi =
+      3.141592653589793238462643383279502884197169399375105820974944;
+  const double phase = -2 * pi * i / nfft;
+  struct complex_int16_t tw;
+  tw.real = floor(.5 + kSampMax * cos(phase));
+  tw.imag = floor(.5 + kSampMax * sin(phase));
+  return tw;
+}
+
+// Mirrors the leaf copies of kissfft's recursive kf_work(), recording which
+// input pair lands in each slot.
+void FillPermutation(uint16_t* out, int input_index, int fstride,
+                     const int* factors) {
+  const int p = factors[0];
+  const int m = factors[1];
+  int q;
+  for (q = 0; q < p; ++q) {
+    if (m == 1) {
+      out[q] = input_index + q * fstride;
+    } else {
+      FillPermutation(out + q * m, input_index + q * fstride, fstride * p,
+                      factors + 2);
+    }
+  }
+}
+
+}  // namespace
+
+const struct FftPow2KernelSet* const kFftPow2ScalarKernels =
+    &fft_pow2::kKernelSet;
+
+const struct FftPow2KernelSet* FftPow2KernelsForTier(int tier) {
+  return CPU_TIER_SELECT(tier, kFftPow2ScalarKernels,
+                         kFftPow2Sse41Kernels, kFftPow2Avx2Kernels,
+                         kFftPow2Avx512Kernels);
+}
+
+int FftPow2Supported(size_t fft_size) {
+  int log2_size;
+  for (log2_size = kFftPow2MinLog2Size; log2_size <= kFftPow2MaxLog2Size;
+       ++log2_size) {
+    if (fft_size == ((size_t)1 << log2_size)) {
+      return 1;
+    }
+  }
+  return 0;
+}
+
+void FftPow2Compute(const struct FftPow2Plan* plan, const int16_t* input,
+                    struct complex_int16_t* output) {
+  FftPow2ComputeBins(plan, input, plan->fft_size, output, 0,
+                     plan->fft_size / 2 + 1);
+}
+
+void FftPow2ComputeBins(const struct FftPow2Plan* plan, const int16_t* input,
+                        size_t input_size, struct complex_int16_t* output,
+                        size_t start_index, size_t end_index) {
+  FftPow2KernelsForTier(CpuActiveTier())
+      ->compute_bins[plan->log2_size - kFftPow2MinLog2Size](
+          plan, input, input_size, output, start_index, end_index);
+}
+
+int FftPow2PopulatePlan(struct FftPow2Plan* plan, size_t fft_size) {
+  memset(plan, 0, sizeof(*plan));
+  if (!FftPow2Supported(fft_size)) {
+    fprintf(stderr, "No specialized FFT for size %zu\n", fft_size);
+    return 0;
+  }
+  plan->fft_size = fft_size;
+  plan->log2_size = 0;
+  while (((size_t)1 << plan->log2_size) < fft_size) {
+    ++plan->log2_size;
+  }
+
+  const int complex_size = fft_size / 2;
+
+  // Same factorization as kf_factor(): powers of four first, then the
+  // remaining two (if any).
+  int factors[2 * kFftPow2MaxLog2Size];
+  int num_factors = 0;
+  int n = complex_size;
+  int num_twiddles = 0;
+  while (n > 1) {
+    const int p = (n % 4 == 0) ? 4 : 2;
+    n /= p;
+    factors[2 * num_factors] = p;
+    factors[2 * num_factors + 1] = n;
+    num_twiddles += (p - 1) * n;
+    ++num_factors;
+  }
+
+  plan->permutation =
+      (uint16_t*)malloc(complex_size * sizeof(*plan->permutation));
+  plan->twiddles =
+      (struct complex_int16_t*)malloc(num_twiddles * sizeof(*plan->twiddles));
+  plan->super_twiddles = (struct complex_int16_t*)malloc(
+      (complex_size / 2) * sizeof(*plan->super_twiddles));
+  const int leaf_radix = factors[2 * (num_factors - 1)];
+  plan->leaf_slots = (uint16_t*)malloc((complex_size / leaf_radix) *
+                                       sizeof(*plan->leaf_slots));
+  if (plan->permutation == NULL || plan->twiddles == NULL ||
+      plan->super_twiddles == NULL || plan->leaf_slots == NULL) {
+    fprintf(stderr, "Failed to alloc fft plan buffers\n");
+    return 0;
+  }
+
+  FillPermutation(plan->permutation, 0, 1, factors);
+  // Each innermost butterfly reads pairs b, b + stride, ..., and is found at
+  // the slot whose permutation entry is b.
+  int slot;
+  for (slot = 0; slot < complex_size; slot += leaf_radix) {
+    plan->leaf_slots[plan->permutation[slot]] = slot;
+  }
+
+  // Stages run innermost first, which is the reverse of the factor order.
+  struct complex_int16_t* twiddles = plan->twiddles;
+  int stage;
+  for (stage = num_factors - 1; stage >= 0; --stage) {
+    const int p = factors[2 * stage];
+    const int m = factors[2 * stage + 1];
+    const int fstride = complex_size / (p * m);
+    int q;
+    for (q = 1; q < p; ++q) {
+      int k;
+      for (k = 0; k < m; ++k) {
+        *twiddles++ = KissTwiddle(q * k * fstride, complex_size);
+      }
+    }
+  }
+
+  // Matches the super_twiddles setup in kiss_fftr_alloc().
+  int i;
+  for (i = 0; i < complex_size / 2; ++i) {
+    const double phase =
+        -3.14159265358979323846264338327 * ((double)(i + 1) / complex_size + .5);
+    plan->super_twiddles[i].real = floor(.5 + kSampMax * cos(phase));
+    plan->super_twiddles[i].imag = floor(.5 + kSampMax * sin(phase));
+  }
+  return 1;
+}
+
+void FftPow2FreePlanContents(struct FftPow2Plan* plan) {
+  free(plan->permutation);
+  free(plan->twiddles);
+  free(plan->super_twiddles);
+  free(plan->leaf_slots);
+}
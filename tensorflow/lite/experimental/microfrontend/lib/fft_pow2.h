@@ -0,0 +1,77 @@
+/* Copyright 2026 The pymicro-features Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef TENSORFLOW_LITE_EXPERIMENTAL_MICROFRONTEND_LIB_FFT_POW2_H_
+#define TENSORFLOW_LITE_EXPERIMENTAL_MICROFRONTEND_LIB_FFT_POW2_H_
+
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "tensorflow/lite/experimental/microfrontend/lib/fft.h"
+
+// Range of real transform sizes (as log2) with a specialized kernel.
+#define kFftPow2MinLog2Size 2
+#define kFftPow2MaxLog2Size 12
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Precomputed tables for a fixed-point real FFT of a power-of-two size. The
+// transform runs the same radix-4 (plus one radix-2 for odd log2 sizes)
+// decomposition as kissfft, but with the stage structure fixed at compile
+// time, so its output is bit-exact with kissfft_fixed16::kiss_fftr.
+struct FftPow2Plan {
+  size_t fft_size;
+  int log2_size;
+  // Input pair index feeding each slot of the complex transform.
+  uint16_t* permutation;
+  // For each input pair b read first by an innermost butterfly, the slot
+  // where that butterfly's outputs start.
+  uint16_t* leaf_slots;
+  // Per-stage twiddles, innermost stage first. A radix-4 stage with span m
+  // stores its m first, m second and m third twiddles back to back.
+  struct complex_int16_t* twiddles;
+  // Twiddles for the final real-input split, fft_size / 4 entries.
+  struct complex_int16_t* super_twiddles;
+};
+
+// Returns non-zero if fft_size has a specialized kernel.
+int FftPow2Supported(size_t fft_size);
+
+// Computes the fft_size / 2 + 1 complex outputs of the real transform of
+// input. The output array must hold fft_size / 2 + 1 values, and is also used
+// as the working buffer of the complex transform.
+void FftPow2Compute(const struct FftPow2Plan* plan, const int16_t* input,
+                    struct complex_int16_t* output);
+
+// Same as FftPow2Compute(), but input samples from input_size on must be
+// zero, and only output bins [start_index, end_index) are guaranteed to be
+// filled in. Butterflies on the zero padding and the real-input split for
+// bins outside of that range are skipped.
+void FftPow2ComputeBins(const struct FftPow2Plan* plan, const int16_t* input,
+                        size_t input_size, struct complex_int16_t* output,
+                        size_t start_index, size_t end_index);
+
+// Allocates and fills the tables for the given transform size.
+int FftPow2PopulatePlan(struct FftPow2Plan* plan, size_t fft_size);
+
+// Frees any allocated buffers.
+void FftPow2FreePlanContents(struct FftPow2Plan* plan);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif  // TENSORFLOW_LITE_EXPERIMENTAL_MICROFRONTEND_LIB_FFT_POW2_H_
@@ -0,0 +1,50 @@
+/* Copyright 2026 The pymicro-features Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tensorflow/lite/experimental/microfrontend/lib/cpu_features.h"
+#include "tensorflow/lite/experimental/microfrontend/lib/fft_pow2_dispatch.h"
+
+// The power-of-two FFT kernels for the AVX2 tier. Only this file is built
+// for AVX2, through target pragmas, and its kernels only run once
+// CpuActiveTier() reports the tier.
+#ifdef CPU_FEATURES_X86
+
+// The intrinsics come first: their own definitions already carry the target
+// attributes they need.
+#include <immintrin.h>
+
+#if defined(__clang__)
+#pragma clang attribute push(__attribute__((target("avx2"))), \
+                             apply_to = function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("avx2")
+#endif
+
+#define FFT_POW2_TIER avx2
+#define FFT_POW2_USE_SSE2
+#define FFT_POW2_USE_SSSE3
+#define FFT_POW2_USE_AVX2
+#include "tensorflow/lite/experimental/microfrontend/lib/fft_pow2_compute.h"
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+const struct FftPow2KernelSet* const kFftPow2Avx2Kernels =
+    &fft_pow2::avx2::kKernelSet;
+
+#endif  // CPU_FEATURES_X86
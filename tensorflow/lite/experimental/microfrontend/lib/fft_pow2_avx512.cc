@@ -0,0 +1,58 @@
+/* Copyright 2026 The pymicro-features Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tensorflow/lite/experimental/microfrontend/lib/cpu_features.h"
+#include "tensorflow/lite/experimental/microfrontend/lib/fft_pow2_dispatch.h"
+
+// The power-of-two FFT kernels for the AVX-512 tier. Only this file is built
+// for AVX-512, through target pragmas, and its kernels only run once
+// CpuActiveTier() reports the tier.
+#ifdef CPU_FEATURES_X86
+
+// The intrinsics come first: their own definitions already carry the target
+// attributes they need.
+#include <immintrin.h>
+
+#if defined(__clang__)
+#pragma clang attribute push(                                             \
+    __attribute__((target("avx512f,avx512bw,avx512dq,avx512vl,avx512cd"))), \
+    apply_to = function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("avx512f,avx512bw,avx512dq,avx512vl,avx512cd")
+// Older GCC's AVX-512 intrinsics start from a self-initialized "undefined"
+// register, which trips these once inlined (GCC bug 105593).
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+
+#define FFT_POW2_TIER avx512
+#define FFT_POW2_USE_SSE2
+#define FFT_POW2_USE_SSSE3
+#define FFT_POW2_USE_AVX2
+#define FFT_POW2_USE_AVX512
+#include "tensorflow/lite/experimental/microfrontend/lib/fft_pow2_compute.h"
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC diagnostic pop
+#pragma GCC pop_options
+#endif
+
+const struct FftPow2KernelSet* const kFftPow2Avx512Kernels =
+    &fft_pow2::avx512::kKernelSet;
+
+#endif  // CPU_FEATURES_X86
@@ -0,0 +1,590 @@
+/* Copyright 2026 The pymicro-features Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef TENSORFLOW_LITE_EXPERIMENTAL_MICROFRONTEND_LIB_FFT_POW2_COMPUTE_H_
+#define TENSORFLOW_LITE_EXPERIMENTAL_MICROFRONTEND_LIB_FFT_POW2_COMPUTE_H_
+
+// C++-only transforms of the power-of-two FFT, built on the ops policies of
+// fft_pow2_kernels.h. Each kernel translation unit includes this once, after
+// choosing its tier and policies, and exports the resulting kKernelSet.
+
+#include "tensorflow/lite/experimental/microfrontend/lib/fft_multi.h"
+#include "tensorflow/lite/experimental/microfrontend/lib/fft_pow2.h"
+#include "tensorflow/lite/experimental/microfrontend/lib/fft_pow2_dispatch.h"
+#include "tensorflow/lite/experimental/microfrontend/lib/fft_pow2_kernels.h"
+
+namespace fft_pow2 {
+inline namespace FFT_POW2_TIER {
+
+// Loads and stores the four legs of a radix-4 butterfly of span m.
+template <class Ops, class Twiddle>
+inline void Butterfly4InPlace(struct complex_int16_t* out, int m,
+                              const Twiddle& tw1, const Twiddle& tw2,
+                              const Twiddle& tw3) {
+  typename Ops::Complex f0 = Ops::Load(out);
+  typename Ops::Complex f1 = Ops::Load(out + m);
+  typename Ops::Complex f2 = Ops::Load(out + 2 * m);
+  typename Ops::Complex f3 = Ops::Load(out + 3 * m);
+  fft_pow2::Butterfly4<Ops>(&f0, &f1, &f2, &f3, tw1, tw2, tw3);
+  Ops::Store(out, f0);
+  Ops::Store(out + m, f1);
+  Ops::Store(out + 2 * m, f2);
+  Ops::Store(out + 3 * m, f3);
+}
+
+template <int kM, int kGroups>
+inline void Radix4StageScalar(struct complex_int16_t* out,
+                              const struct complex_int16_t* twiddles) {
+  for (int g = 0; g < kGroups; ++g) {
+    struct complex_int16_t* group = out + 4 * kM * g;
+    Butterfly4InPlace<ScalarOps>(group, kM, UnitTwiddle(), UnitTwiddle(),
+                                 UnitTwiddle());
+    for (int k = 1; k < kM; ++k) {
+      Butterfly4InPlace<ScalarOps>(group + k, kM, twiddles[k],
+                                   twiddles[kM + k], twiddles[2 * kM + k]);
+    }
+  }
+}
+
+// Spans of at least the register width: each register holds the same leg of
+// kWidth neighbouring butterflies, so the twiddles load straight from the
+// table and are reused across all groups.
+template <class Ops, int kM, int kGroups>
+inline void Radix4StageVector(struct complex_int16_t* out,
+                              const struct complex_int16_t* twiddles) {
+  for (int k = 0; k < kM; k += Ops::kWidth) {
+    const typename Ops::Twiddle tw1 = Ops::LoadTwiddle(twiddles + k);
+    const typename Ops::Twiddle tw2 = Ops::LoadTwiddle(twiddles + kM + k);
+    const typename Ops::Twiddle tw3 = Ops::LoadTwiddle(twiddles + 2 * kM + k);
+    for (int g = 0; g < kGroups; ++g) {
+      Butterfly4InPlace<Ops>(out + 4 * kM * g + k, kM, tw1, tw2, tw3);
+    }
+  }
+}
+
+#ifdef FFT_POW2_USE_SSE2
+// Radix-4 stage of span two, two groups (four butterflies) at a time.
+template <int kGroups>
+inline void Radix4StageSse2Span2(struct complex_int16_t* out,
+                                 const struct complex_int16_t* twiddles) {
+  // Twiddles for k = 0, 1 of both groups in a register.
+  const __m128i t1 =
+      _mm_loadl_epi64(reinterpret_cast<const __m128i*>(twiddles));
+  const __m128i t2 =
+      _mm_loadl_epi64(reinterpret_cast<const __m128i*>(twiddles + 2));
+  const __m128i t3 =
+      _mm_loadl_epi64(reinterpret_cast<const __m128i*>(twiddles + 4));
+  const Sse2Ops::Twiddle tw1 = Sse2Ops::MakeTwiddle(_mm_unpacklo_epi64(t1, t1));
+  const Sse2Ops::Twiddle tw2 = Sse2Ops::MakeTwiddle(_mm_unpacklo_epi64(t2, t2));
+  const Sse2Ops::Twiddle tw3 = Sse2Ops::MakeTwiddle(_mm_unpacklo_epi64(t3, t3));
+  for (int g = 0; g < kGroups; g += 2) {
+    struct complex_int16_t* group = out + 8 * g;
+    const __m128i a0 = Sse2Ops::Load(group);
+    const __m128i a1 = Sse2Ops::Load(group + 4);
+    const __m128i b0 = Sse2Ops::Load(group + 8);
+    const __m128i b1 = Sse2Ops::Load(group + 12);
+    __m128i f0 = _mm_unpacklo_epi64(a0, b0);
+    __m128i f1 = _mm_unpackhi_epi64(a0, b0);
+    __m128i f2 = _mm_unpacklo_epi64(a1, b1);
+    __m128i f3 = _mm_unpackhi_epi64(a1, b1);
+    fft_pow2::Butterfly4<Sse2Ops>(&f0, &f1, &f2, &f3, tw1, tw2, tw3);
+    Sse2Ops::Store(group, _mm_unpacklo_epi64(f0, f1));
+    Sse2Ops::Store(group + 4, _mm_unpacklo_epi64(f2, f3));
+    Sse2Ops::Store(group + 8, _mm_unpackhi_epi64(f0, f1));
+    Sse2Ops::Store(group + 12, _mm_unpackhi_epi64(f2, f3));
+  }
+}
+#endif  // FFT_POW2_USE_SSE2
+
+// One radix-4 stage, made of kGroups independent butterfly groups of span kM.
+// Uses the widest kernel the span allows; all of them give the same result.
+template <int kM, int kGroups>
+inline void Radix4Stage(struct complex_int16_t* out,
+                        const struct complex_int16_t* twiddles) {
+#ifdef FFT_POW2_USE_AVX512
+  if (kM >= Avx512Ops::kWidth) {
+    Radix4StageVector<Avx512Ops, kM, kGroups>(out, twiddles);
+    return;
+  }
+#endif
+#ifdef FFT_POW2_USE_AVX2
+  if (kM >= Avx2Ops::kWidth) {
+    Radix4StageVector<Avx2Ops, kM, kGroups>(out, twiddles);
+    return;
+  }
+#endif
+#ifdef FFT_POW2_USE_SSE2
+  if (kM >= Sse2Ops::kWidth) {
+    Radix4StageVector<Sse2Ops, kM, kGroups>(out, twiddles);
+    return;
+  }
+  if (kM == 2 && kGroups % 2 == 0) {
+    Radix4StageSse2Span2<kGroups>(out, twiddles);
+    return;
+  }
+#endif
+  Radix4StageScalar<kM, kGroups>(out, twiddles);
+}
+
+// Runs the radix-4 stages of a complex transform of size 2^kLog2Size, from
+// span 2^kLog2M outwards.
+template <int kLog2Size, int kLog2M, bool kDone = (kLog2M + 2 > kLog2Size)>
+struct Radix4Stages {
+  static inline void Run(struct complex_int16_t* out,
+                         const struct complex_int16_t* twiddles) {
+    Radix4Stage<(1 << kLog2M), (1 << (kLog2Size - kLog2M - 2))>(out,
+                                                                twiddles);
+    Radix4Stages<kLog2Size, kLog2M + 2>::Run(out,
+                                             twiddles + 3 * (1 << kLog2M));
+  }
+};
+
+template <int kLog2Size, int kLog2M>
+struct Radix4Stages<kLog2Size, kLog2M, true> {
+  static inline void Run(struct complex_int16_t*,
+                         const struct complex_int16_t*) {}
+};
+
+// The innermost stage is fused with the input permutation. Its butterfly for
+// input pair b reads pairs b, b + kStride, ... straight from the input and
+// writes its outputs to the slots from leaf_slots[b] on. Legs from kLiveLegs
+// on are past the end of the input, i.e. zero padding. Each function handles
+// pairs [b, b_end) and returns the first one left to do.
+template <int kStride, int kLiveLegs>
+inline int LeafBlocks2Scalar(const struct complex_int16_t* in,
+                             struct complex_int16_t* out,
+                             const uint16_t* leaf_slots, int b, int b_end) {
+  for (; b < b_end; ++b) {
+    struct complex_int16_t f0 = in[b];
+    struct complex_int16_t f1 = in[b + kStride];
+    fft_pow2::LeafButterfly2<ScalarOps, kLiveLegs>(&f0, &f1);
+    struct complex_int16_t* group = out + leaf_slots[b];
+    group[0] = f0;
+    group[1] = f1;
+  }
+  return b;
+}
+
+template <int kStride, int kLiveLegs>
+inline int LeafBlocks4Scalar(const struct complex_int16_t* in,
+                             struct complex_int16_t* out,
+                             const uint16_t* leaf_slots, int b, int b_end) {
+  for (; b < b_end; ++b) {
+    struct complex_int16_t f0 = in[b];
+    struct complex_int16_t f1 = in[b + kStride];
+    struct complex_int16_t f2 = in[b + 2 * kStride];
+    struct complex_int16_t f3 = in[b + 3 * kStride];
+    fft_pow2::LeafButterfly4<ScalarOps, kLiveLegs>(&f0, &f1, &f2, &f3);
+    struct complex_int16_t* group = out + leaf_slots[b];
+    group[0] = f0;
+    group[1] = f1;
+    group[2] = f2;
+    group[3] = f3;
+  }
+  return b;
+}
+
+#ifdef FFT_POW2_USE_SSE2
+// Four neighbouring pairs per register, transposed back to one butterfly per
+// register (or half register) for the scattered stores.
+template <int kStride, int kLiveLegs>
+inline int LeafBlocks2Sse2(const struct complex_int16_t* in,
+                           struct complex_int16_t* out,
+                           const uint16_t* leaf_slots, int b, int b_end) {
+  for (; b < b_end; b += 4) {
+    __m128i f0 = Sse2Ops::Load(in + b);
+    __m128i f1 = Sse2Ops::Load(in + b + kStride);
+    fft_pow2::LeafButterfly2<Sse2Ops, kLiveLegs>(&f0, &f1);
+    const __m128i lo = _mm_unpacklo_epi32(f0, f1);
+    const __m128i hi = _mm_unpackhi_epi32(f0, f1);
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(out + leaf_slots[b]), lo);
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(out + leaf_slots[b + 1]),
+                     _mm_unpackhi_epi64(lo, lo));
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(out + leaf_slots[b + 2]), hi);
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(out + leaf_slots[b + 3]),
+                     _mm_unpackhi_epi64(hi, hi));
+  }
+  return b;
+}
+
+template <int kStride, int kLiveLegs>
+inline int LeafBlocks4Sse2(const struct complex_int16_t* in,
+                           struct complex_int16_t* out,
+                           const uint16_t* leaf_slots, int b, int b_end) {
+  for (; b < b_end; b += 4) {
+    __m128i f0 = Sse2Ops::Load(in + b);
+    __m128i f1 = Sse2Ops::Load(in + b + kStride);
+    __m128i f2 = Sse2Ops::Load(in + b + 2 * kStride);
+    __m128i f3 = Sse2Ops::Load(in + b + 3 * kStride);
+    fft_pow2::LeafButterfly4<Sse2Ops, kLiveLegs>(&f0, &f1, &f2, &f3);
+    Sse2Ops::Transpose(&f0, &f1, &f2, &f3);
+    Sse2Ops::Store(out + leaf_slots[b], f0);
+    Sse2Ops::Store(out + leaf_slots[b + 1], f1);
+    Sse2Ops::Store(out + leaf_slots[b + 2], f2);
+    Sse2Ops::Store(out + leaf_slots[b + 3], f3);
+  }
+  return b;
+}
+#endif  // FFT_POW2_USE_SSE2
+
+template <int kStride, int kLiveLegs>
+inline int LeafBlocks2(const struct complex_int16_t* in,
+                       struct complex_int16_t* out, const uint16_t* leaf_slots,
+                       int b, int b_end) {
+  if (b_end > kStride) {
+    b_end = kStride;
+  }
+#ifdef FFT_POW2_USE_SSE2
+  if (kStride % 4 == 0) {
+    return LeafBlocks2Sse2<kStride, kLiveLegs>(in, out, leaf_slots, b, b_end);
+  }
+#endif
+  return LeafBlocks2Scalar<kStride, kLiveLegs>(in, out, leaf_slots, b, b_end);
+}
+
+template <int kStride, int kLiveLegs>
+inline int LeafBlocks4(const struct complex_int16_t* in,
+                       struct complex_int16_t* out, const uint16_t* leaf_slots,
+                       int b, int b_end) {
+  if (b_end > kStride) {
+    b_end = kStride;
+  }
+#ifdef FFT_POW2_USE_SSE2
+  if (kStride % 4 == 0) {
+    return LeafBlocks4Sse2<kStride, kLiveLegs>(in, out, leaf_slots, b, b_end);
+  }
+#endif
+  return LeafBlocks4Scalar<kStride, kLiveLegs>(in, out, leaf_slots, b, b_end);
+}
+
+// Innermost radix-2 stage of a complex transform of size kSize, whose input
+// pairs from num_pairs on are zero. Leg q of the butterfly for pair b is
+// live if b + q * kStride < num_pairs.
+template <int kSize>
+inline void LeafStage2(const int16_t* input, struct complex_int16_t* out,
+                       const uint16_t* leaf_slots, int num_pairs) {
+  const int kStride = kSize / 2;
+  const struct complex_int16_t* in =
+      reinterpret_cast<const struct complex_int16_t*>(input);
+  int b = 0;
+  b = LeafBlocks2<kStride, 2>(in, out, leaf_slots, b, num_pairs - kStride);
+  LeafBlocks2<kStride, 1>(in, out, leaf_slots, b, kStride);
+}
+
+// Innermost radix-4 stage, likewise.
+template <int kSize>
+inline void LeafStage4(const int16_t* input, struct complex_int16_t* out,
+                       const uint16_t* leaf_slots, int num_pairs) {
+  const int kStride = kSize / 4;
+  const struct complex_int16_t* in =
+      reinterpret_cast<const struct complex_int16_t*>(input);
+  int b = 0;
+  b = LeafBlocks4<kStride, 4>(in, out, leaf_slots, b,
+                              num_pairs - 3 * kStride);
+  b = LeafBlocks4<kStride, 3>(in, out, leaf_slots, b,
+                              num_pairs - 2 * kStride);
+  b = LeafBlocks4<kStride, 2>(in, out, leaf_slots, b, num_pairs - kStride);
+  LeafBlocks4<kStride, 1>(in, out, leaf_slots, b, kStride);
+}
+
+// Splits pairs [k, k_end) with ops of any width, as long as a whole register
+// of pairs fits without the low and high halves overlapping. Returns the
+// first pair left to do.
+template <class Ops, int kSize>
+inline int RealSplitBlocks(struct complex_int16_t* out,
+                           const struct complex_int16_t* super_twiddles, int k,
+                           int k_end) {
+  for (; k + Ops::kWidth <= k_end && 2 * (k + Ops::kWidth) - 2 < kSize;
+       k += Ops::kWidth) {
+    struct complex_int16_t* high = out + kSize - k - (Ops::kWidth - 1);
+    typename Ops::Complex bin_k = Ops::Load(out + k);
+    typename Ops::Complex bin_nk = Ops::Reverse(Ops::Load(high));
+    fft_pow2::RealSplitPair<Ops>(&bin_k, &bin_nk,
+                                 Ops::LoadTwiddle(super_twiddles + k - 1));
+    Ops::Store(out + k, bin_k);
+    Ops::Store(high, Ops::Reverse(bin_nk));
+  }
+  return k;
+}
+
+// Splits pairs [k, k_end), where pair k yields bins k and kSize - k.
+template <int kSize>
+inline void RealSplitPairs(struct complex_int16_t* out,
+                           const struct complex_int16_t* super_twiddles, int k,
+                           int k_end) {
+#ifdef FFT_POW2_USE_AVX512
+  k = RealSplitBlocks<Avx512Ops, kSize>(out, super_twiddles, k, k_end);
+#endif
+#ifdef FFT_POW2_USE_AVX2
+  k = RealSplitBlocks<Avx2Ops, kSize>(out, super_twiddles, k, k_end);
+#endif
+#ifdef FFT_POW2_USE_SSE2
+  k = RealSplitBlocks<Sse2Ops, kSize>(out, super_twiddles, k, k_end);
+#endif
+  for (; k < k_end; ++k) {
+    struct complex_int16_t bin_k = out[k];
+    struct complex_int16_t bin_nk = out[kSize - k];
+    fft_pow2::RealSplitPair<ScalarOps>(&bin_k, &bin_nk,
+                                       super_twiddles[k - 1]);
+    out[k] = bin_k;
+    out[kSize - k] = bin_nk;
+  }
+}
+
+// The final part of kiss_fftr(): splits the half-size complex transform into
+// the spectrum of the real input. Done in place, since each iteration reads
+// both of the slots it writes. Only the pairs that produce a bin in
+// [start_index, end_index) are split; the other bins are left undefined.
+template <int kSize>
+inline void RealSplit(struct complex_int16_t* out,
+                      const struct complex_int16_t* super_twiddles,
+                      int start_index, int end_index) {
+  const struct complex_int16_t tdc = ScalarOps::FixDiv<2>(out[0]);
+  out[0].real = tdc.real + tdc.imag;
+  out[0].imag = 0;
+  out[kSize].real = tdc.real - tdc.imag;
+  out[kSize].imag = 0;
+
+  // Pairs for the wanted bins in the lower half, and for the wanted bins in
+  // the upper half (bin b comes from pair kSize - b).
+  const int low_begin = (start_index > 1) ? start_index : 1;
+  const int low_end = (end_index < kSize / 2 + 1) ? end_index : kSize / 2 + 1;
+  const int high_begin = kSize + 1 - ((end_index < kSize) ? end_index : kSize);
+  const int high_end =
+      kSize + 1 - ((start_index > kSize / 2 + 1) ? start_index : kSize / 2 + 1);
+  if (low_begin >= low_end) {
+    RealSplitPairs<kSize>(out, super_twiddles, high_begin, high_end);
+  } else if (high_begin >= high_end) {
+    RealSplitPairs<kSize>(out, super_twiddles, low_begin, low_end);
+  } else if (high_begin <= low_end && low_begin <= high_end) {
+    RealSplitPairs<kSize>(out, super_twiddles,
+                          (low_begin < high_begin) ? low_begin : high_begin,
+                          (low_end > high_end) ? low_end : high_end);
+  } else {
+    RealSplitPairs<kSize>(out, super_twiddles, low_begin, low_end);
+    RealSplitPairs<kSize>(out, super_twiddles, high_begin, high_end);
+  }
+}
+
+// Real transform of size 2^kLog2Size, computed through a complex transform
+// of half that size.
+template <int kLog2Size>
+void ComputeRealFft(const struct FftPow2Plan* plan, const int16_t* input,
+                    int input_size, struct complex_int16_t* output,
+                    int start_index, int end_index) {
+  const int kLog2ComplexSize = kLog2Size - 1;
+  const int kComplexSize = 1 << kLog2ComplexSize;
+  const int num_pairs = (input_size + 1) / 2;
+
+  const struct complex_int16_t* twiddles = plan->twiddles;
+  if (kLog2ComplexSize & 1) {
+    LeafStage2<kComplexSize>(input, output, plan->leaf_slots, num_pairs);
+    Radix4Stages<kLog2ComplexSize, 1>::Run(output, twiddles + 1);
+  } else {
+    LeafStage4<kComplexSize>(input, output, plan->leaf_slots, num_pairs);
+    Radix4Stages<kLog2ComplexSize, 2>::Run(output, twiddles + 3);
+  }
+
+  RealSplit<kComplexSize>(output, plan->super_twiddles, start_index,
+                          end_index);
+}
+
+#ifdef FFT_POW2_USE_SSE2
+// The multi-stream transform, one stream per lane.
+#if defined(FFT_POW2_USE_AVX2)
+typedef Avx2LaneOps LaneOps;
+#else
+typedef Sse2LaneOps LaneOps;
+#endif
+
+const int kNumLanes = LaneOps::kLanes;
+
+// Interleaves the scaled inputs of up to kNumLanes streams sample by sample,
+// eight streams and eight samples per transpose. Unused lanes are zeroed.
+void GatherInput(struct FftMultiState* state, struct FftState* const* states,
+                 int num_streams) {
+  const size_t fft_size = state->fft_size;
+  int16_t* input = state->input;
+  int lane;
+  for (lane = 0; lane < kNumLanes; lane += 8) {
+    const int16_t* rows[8];
+    int j;
+    for (j = 0; j < 8; ++j) {
+      rows[j] = (lane + j < num_streams) ? states[lane + j]->input : nullptr;
+    }
+    size_t i = 0;
+    for (; i + 8 <= fft_size; i += 8) {
+      __m128i r[8];
+      for (j = 0; j < 8; ++j) {
+        r[j] = rows[j] ? _mm_loadu_si128(
+                             reinterpret_cast<const __m128i*>(rows[j] + i))
+                       : _mm_setzero_si128();
+      }
+      fft_pow2::Transpose8x8(r);
+      for (j = 0; j < 8; ++j) {
+        _mm_storeu_si128(
+            reinterpret_cast<__m128i*>(input + (i + j) * kNumLanes + lane),
+            r[j]);
+      }
+    }
+    for (; i < fft_size; ++i) {
+      for (j = 0; j < 8; ++j) {
+        input[i * kNumLanes + lane + j] = rows[j] ? rows[j][i] : 0;
+      }
+    }
+  }
+}
+
+template <class Twiddle>
+inline void LaneButterfly4InPlace(LaneOps::Storage* f, int m,
+                                  const Twiddle& tw1, const Twiddle& tw2,
+                                  const Twiddle& tw3) {
+  LaneOps::Complex f0 = LaneOps::Load(f);
+  LaneOps::Complex f1 = LaneOps::Load(f + m);
+  LaneOps::Complex f2 = LaneOps::Load(f + 2 * m);
+  LaneOps::Complex f3 = LaneOps::Load(f + 3 * m);
+  fft_pow2::Butterfly4<LaneOps>(&f0, &f1, &f2, &f3, tw1, tw2, tw3);
+  LaneOps::Store(f, f0);
+  LaneOps::Store(f + m, f1);
+  LaneOps::Store(f + 2 * m, f2);
+  LaneOps::Store(f + 3 * m, f3);
+}
+
+// The same transform as ComputeRealFft(), on every lane. The
+// per-call work is large enough that the stages are plain loops.
+void ComputeLanes(struct FftMultiState* state) {
+  typedef LaneOps::Storage Storage;
+  typedef LaneOps::Complex Complex;
+  typedef LaneOps::Twiddle Twiddle;
+  const int complex_size = state->fft_size / 2;
+  const struct FftPow2Plan* plan = state->plan;
+  // Each input pair is one Storage block: the real parts from the even
+  // sample, the imaginary parts from the odd one.
+  const Storage* pairs = reinterpret_cast<const Storage*>(state->input);
+  Storage* out = reinterpret_cast<Storage*>(state->work);
+
+  int i;
+  for (i = 0; i < complex_size; ++i) {
+    out[i] = pairs[plan->permutation[i]];
+  }
+
+  const struct complex_int16_t* twiddles = plan->twiddles;
+  int m = 1;
+  if ((plan->log2_size - 1) & 1) {
+    int g;
+    for (g = 0; g < complex_size / 2; ++g) {
+      Complex f0 = LaneOps::Load(out + 2 * g);
+      Complex f1 = LaneOps::Load(out + 2 * g + 1);
+      fft_pow2::Butterfly2<LaneOps>(&f0, &f1, fft_pow2::UnitTwiddle());
+      LaneOps::Store(out + 2 * g, f0);
+      LaneOps::Store(out + 2 * g + 1, f1);
+    }
+    ++twiddles;
+    m = 2;
+  }
+  for (; m < complex_size; m *= 4) {
+    const int num_groups = complex_size / (4 * m);
+    int g;
+    for (g = 0; g < num_groups; ++g) {
+      LaneButterfly4InPlace(out + 4 * m * g, m, fft_pow2::UnitTwiddle(),
+                            fft_pow2::UnitTwiddle(), fft_pow2::UnitTwiddle());
+    }
+    int k;
+    for (k = 1; k < m; ++k) {
+      const Twiddle tw1 = LaneOps::LoadTwiddle(twiddles + k);
+      const Twiddle tw2 = LaneOps::LoadTwiddle(twiddles + m + k);
+      const Twiddle tw3 = LaneOps::LoadTwiddle(twiddles + 2 * m + k);
+      for (g = 0; g < num_groups; ++g) {
+        LaneButterfly4InPlace(out + 4 * m * g + k, m, tw1, tw2, tw3);
+      }
+    }
+    twiddles += 3 * m;
+  }
+
+  Complex dc;
+  Complex nyquist;
+  LaneOps::SplitDc(LaneOps::FixDiv<2>(LaneOps::Load(out)), &dc, &nyquist);
+  LaneOps::Store(out, dc);
+  LaneOps::Store(out + complex_size, nyquist);
+  int k;
+  for (k = 1; k <= complex_size / 2; ++k) {
+    Complex bin_k = LaneOps::Load(out + k);
+    Complex bin_nk = LaneOps::Load(out + complex_size - k);
+    fft_pow2::RealSplitPair<LaneOps>(
+        &bin_k, &bin_nk, LaneOps::LoadTwiddle(plan->super_twiddles + k - 1));
+    LaneOps::Store(out + k, bin_k);
+    LaneOps::Store(out + complex_size - k, bin_nk);
+  }
+}
+
+// Copies each lane's spectrum to its stream's output, four bins of eight
+// streams per transpose.
+void ScatterOutput(const struct FftMultiState* state,
+                   struct FftState* const* states, int num_streams) {
+  const LaneOps::Storage* work =
+      reinterpret_cast<const LaneOps::Storage*>(state->work);
+  const size_t num_bins = state->fft_size / 2 + 1;
+  int lane;
+  for (lane = 0; lane < num_streams; lane += 8) {
+    size_t k = 0;
+    int j;
+    for (; k + 4 <= num_bins; k += 4) {
+      __m128i r[8];
+      for (j = 0; j < 4; ++j) {
+        r[2 * j] = _mm_loadu_si128(
+            reinterpret_cast<const __m128i*>(work[k + j].real + lane));
+        r[2 * j + 1] = _mm_loadu_si128(
+            reinterpret_cast<const __m128i*>(work[k + j].imag + lane));
+      }
+      fft_pow2::Transpose8x8(r);
+      for (j = 0; j < 8 && lane + j < num_streams; ++j) {
+        _mm_storeu_si128(
+            reinterpret_cast<__m128i*>(states[lane + j]->output + k), r[j]);
+      }
+    }
+    for (; k < num_bins; ++k) {
+      for (j = 0; j < 8 && lane + j < num_streams; ++j) {
+        states[lane + j]->output[k].real = work[k].real[lane + j];
+        states[lane + j]->output[k].imag = work[k].imag[lane + j];
+      }
+    }
+  }
+}
+
+void ComputeStreams(struct FftMultiState* state,
+                    struct FftState* const* states, int num_streams) {
+  GatherInput(state, states, num_streams);
+  ComputeLanes(state);
+  ScatterOutput(state, states, num_streams);
+}
+#endif  // FFT_POW2_USE_SSE2
+
+const struct FftPow2KernelSet kKernelSet = {
+    {ComputeRealFft<2>, ComputeRealFft<3>, ComputeRealFft<4>,
+     ComputeRealFft<5>, ComputeRealFft<6>, ComputeRealFft<7>,
+     ComputeRealFft<8>, ComputeRealFft<9>, ComputeRealFft<10>,
+     ComputeRealFft<11>, ComputeRealFft<12>},
+#ifdef FFT_POW2_USE_SSE2
+    kNumLanes,
+    ComputeStreams,
+#else
+    1,
+    nullptr,
+#endif
+};
+
+}  // namespace FFT_POW2_TIER
+}  // namespace fft_pow2
+
+#endif  // TENSORFLOW_LITE_EXPERIMENTAL_MICROFRONTEND_LIB_FFT_POW2_COMPUTE_H_
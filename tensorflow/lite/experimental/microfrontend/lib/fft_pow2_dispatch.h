@@ -0,0 +1,61 @@
+/* Copyright 2026 The pymicro-features Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef TENSORFLOW_LITE_EXPERIMENTAL_MICROFRONTEND_LIB_FFT_POW2_DISPATCH_H_
+#define TENSORFLOW_LITE_EXPERIMENTAL_MICROFRONTEND_LIB_FFT_POW2_DISPATCH_H_
+
+#include <stdint.h>
+
+#include "tensorflow/lite/experimental/microfrontend/lib/cpu_features.h"
+#include "tensorflow/lite/experimental/microfrontend/lib/fft.h"
+#include "tensorflow/lite/experimental/microfrontend/lib/fft_multi.h"
+#include "tensorflow/lite/experimental/microfrontend/lib/fft_pow2.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// The power-of-two FFT kernels built for one CPU tier (see cpu_features.h).
+// fft_pow2.cc holds the scalar set, and fft_pow2_<tier>.cc the others.
+struct FftPow2KernelSet {
+  // FftPow2ComputeBins() for each log2 size from kFftPow2MinLog2Size on.
+  void (*compute_bins[kFftPow2MaxLog2Size - kFftPow2MinLog2Size + 1])(
+      const struct FftPow2Plan* plan, const int16_t* input, int input_size,
+      struct complex_int16_t* output, int start_index, int end_index);
+  // Streams one FftMultiCompute() batch transforms in lockstep. With a single
+  // lane there is no compute_lanes, and each stream is transformed on its
+  // own.
+  int num_lanes;
+  // Transforms the already scaled inputs of up to num_lanes states, using
+  // the buffers of state.
+  void (*compute_lanes)(struct FftMultiState* state,
+                        struct FftState* const* states, int num_streams);
+};
+
+extern const struct FftPow2KernelSet* const kFftPow2ScalarKernels;
+#ifdef CPU_FEATURES_X86
+extern const struct FftPow2KernelSet* const kFftPow2Sse41Kernels;
+extern const struct FftPow2KernelSet* const kFftPow2Avx2Kernels;
+extern const struct FftPow2KernelSet* const kFftPow2Avx512Kernels;
+#endif
+
+// Returns the kernels for the given tier, or for the highest one below it
+// that has its own kernels.
+const struct FftPow2KernelSet* FftPow2KernelsForTier(int tier);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif  // TENSORFLOW_LITE_EXPERIMENTAL_MICROFRONTEND_LIB_FFT_POW2_DISPATCH_H_
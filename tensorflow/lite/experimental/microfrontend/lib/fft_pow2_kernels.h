@@ -0,0 +1,809 @@
+/* Copyright 2026 The pymicro-features Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef TENSORFLOW_LITE_EXPERIMENTAL_MICROFRONTEND_LIB_FFT_POW2_KERNELS_H_
+#define TENSORFLOW_LITE_EXPERIMENTAL_MICROFRONTEND_LIB_FFT_POW2_KERNELS_H_
+
+// C++-only building blocks of the power-of-two FFT. The butterflies are
+// written once against an "ops" policy, which defines the complex value type
+// and the kissfft arithmetic on it:
+//   FixDiv<k>(a)        C_FIXDIV(a, k)
+//   Mul(a, tw)          C_MUL(a, tw)
+//   Add(a, b), Sub(a, b) with int16_t wrap-around
+//   MulMinusI(a)        a * -i, i.e. (a.imag, -a.real)
+//   Conj(a)             (a.real, -a.imag)
+//   HalfAdd(a, b)       ((a.real + b.real) >> 1, (a.imag + b.imag) >> 1)
+//   HalfSubConj(a, b)   ((a.real - b.real) >> 1, (b.imag - a.imag) >> 1)
+// Every op truncates to int16_t exactly where the FIXED_POINT=16 macros in
+// _kiss_fft_guts.h do, so all policies produce bit-identical results.
+//
+// The including translation unit picks the policies by defining
+// FFT_POW2_USE_SSE2, FFT_POW2_USE_SSSE3, FFT_POW2_USE_AVX2 and
+// FFT_POW2_USE_AVX512, and names its CPU tier with FFT_POW2_TIER. Everything
+// here goes into an inline namespace of that name, so the copies built for
+// different tiers (with different target flags) never get merged by the
+// linker.
+
+#include <stdint.h>
+
+#include "tensorflow/lite/experimental/microfrontend/lib/fft.h"
+
+#ifndef FFT_POW2_TIER
+#define FFT_POW2_TIER scalar
+#endif
+#ifdef FFT_POW2_USE_SSE2
+#include <emmintrin.h>
+#endif
+#ifdef FFT_POW2_USE_SSSE3
+#include <tmmintrin.h>
+#endif
+#if defined(FFT_POW2_USE_AVX2) || defined(FFT_POW2_USE_AVX512)
+#include <immintrin.h>
+#endif
+
+namespace fft_pow2 {
+inline namespace FFT_POW2_TIER {
+
+const int32_t kSampMax = 32767;
+
+// One complex value at a time, in plain C++.
+struct ScalarOps {
+  typedef struct complex_int16_t Complex;
+  typedef struct complex_int16_t Twiddle;
+  static const int kWidth = 1;
+
+  static inline int16_t Round15(int32_t x) {
+    return static_cast<int16_t>((x + (1 << 14)) >> 15);
+  }
+
+  static inline Complex Load(const struct complex_int16_t* p) { return *p; }
+  static inline void Store(struct complex_int16_t* p, Complex a) { *p = a; }
+  static inline Twiddle LoadTwiddle(const struct complex_int16_t* p) {
+    return *p;
+  }
+
+  template <int kDiv>
+  static inline Complex FixDiv(Complex a) {
+    a.real = Round15(static_cast<int32_t>(a.real) * (kSampMax / kDiv));
+    a.imag = Round15(static_cast<int32_t>(a.imag) * (kSampMax / kDiv));
+    return a;
+  }
+
+  static inline Complex Mul(const Complex a, const Twiddle b) {
+    Complex m;
+    m.real = Round15(static_cast<int32_t>(a.real) * b.real -
+                     static_cast<int32_t>(a.imag) * b.imag);
+    m.imag = Round15(static_cast<int32_t>(a.real) * b.imag +
+                     static_cast<int32_t>(a.imag) * b.real);
+    return m;
+  }
+
+  static inline Complex Add(const Complex a, const Complex b) {
+    Complex m;
+    m.real = a.real + b.real;
+    m.imag = a.imag + b.imag;
+    return m;
+  }
+
+  static inline Complex Sub(const Complex a, const Complex b) {
+    Complex m;
+    m.real = a.real - b.real;
+    m.imag = a.imag - b.imag;
+    return m;
+  }
+
+  static inline Complex MulMinusI(const Complex a) {
+    Complex m;
+    m.real = a.imag;
+    m.imag = -a.real;
+    return m;
+  }
+
+  static inline Complex Conj(Complex a) {
+    a.imag = -a.imag;
+    return a;
+  }
+
+  static inline Complex HalfAdd(const Complex a, const Complex b) {
+    Complex m;
+    m.real = (a.real + b.real) >> 1;
+    m.imag = (a.imag + b.imag) >> 1;
+    return m;
+  }
+
+  static inline Complex HalfSubConj(const Complex a, const Complex b) {
+    Complex m;
+    m.real = (a.real - b.real) >> 1;
+    m.imag = (b.imag - a.imag) >> 1;
+    return m;
+  }
+};
+
+#ifdef FFT_POW2_USE_SSE2
+// Four consecutive complex values per register, interleaved as in memory.
+struct Sse2Ops {
+  typedef __m128i Complex;
+  // C_MUL operands for _mm_madd_epi16: (br, -bi) pairs give the real part and
+  // (bi, br) pairs the imaginary part.
+  struct Twiddle {
+    __m128i real;
+    __m128i imag;
+  };
+  static const int kWidth = 4;
+
+  static inline Complex Load(const struct complex_int16_t* p) {
+    return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+  }
+  static inline void Store(struct complex_int16_t* p, Complex a) {
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(p), a);
+  }
+
+  static inline __m128i Swap(const __m128i a) {
+    return _mm_shufflehi_epi16(_mm_shufflelo_epi16(a, _MM_SHUFFLE(2, 3, 0, 1)),
+                               _MM_SHUFFLE(2, 3, 0, 1));
+  }
+  static inline __m128i Reverse(const __m128i a) {
+    return _mm_shuffle_epi32(a, _MM_SHUFFLE(0, 1, 2, 3));
+  }
+
+  static inline Twiddle MakeTwiddle(const __m128i b) {
+    Twiddle tw;
+    tw.real = Conj(b);
+    tw.imag = Swap(b);
+    return tw;
+  }
+  static inline Twiddle LoadTwiddle(const struct complex_int16_t* p) {
+    return MakeTwiddle(Load(p));
+  }
+
+  template <int kDiv>
+  static inline Complex FixDiv(const Complex a) {
+    const __m128i scale = _mm_set1_epi16(kSampMax / kDiv);
+#ifdef FFT_POW2_USE_SSSE3
+    return _mm_mulhrs_epi16(a, scale);
+#else
+    const __m128i lo = _mm_mullo_epi16(a, scale);
+    const __m128i hi = _mm_mulhi_epi16(a, scale);
+    const __m128i round = _mm_set1_epi32(1 << 14);
+    return _mm_packs_epi32(
+        _mm_srai_epi32(_mm_add_epi32(_mm_unpacklo_epi16(lo, hi), round), 15),
+        _mm_srai_epi32(_mm_add_epi32(_mm_unpackhi_epi16(lo, hi), round), 15));
+#endif
+  }
+
+  static inline Complex Mul(const Complex a, const Twiddle& b) {
+    const __m128i round = _mm_set1_epi32(1 << 14);
+    const __m128i real = _mm_srai_epi32(
+        _mm_add_epi32(_mm_madd_epi16(a, b.real), round), 15);
+    const __m128i imag = _mm_srai_epi32(
+        _mm_add_epi32(_mm_madd_epi16(a, b.imag), round), 15);
+    // Keep the low 16 bits of each, like the int16_t cast in sround().
+    return _mm_or_si128(_mm_and_si128(real, _mm_set1_epi32(0xFFFF)),
+                        _mm_slli_epi32(imag, 16));
+  }
+
+  static inline Complex Add(const Complex a, const Complex b) {
+    return _mm_add_epi16(a, b);
+  }
+  static inline Complex Sub(const Complex a, const Complex b) {
+    return _mm_sub_epi16(a, b);
+  }
+
+  static inline Complex Conj(const Complex a) {
+    const __m128i imag_mask = _mm_set1_epi32(static_cast<int>(0xFFFF0000));
+    return _mm_sub_epi16(_mm_xor_si128(a, imag_mask), imag_mask);
+  }
+  static inline Complex MulMinusI(const Complex a) { return Conj(Swap(a)); }
+
+  // floor((a + b) / 2) and floor((a - b) / 2) without leaving 16 bits.
+  static inline __m128i HalfAdd16(const __m128i a, const __m128i b) {
+    const __m128i carry =
+        _mm_and_si128(_mm_and_si128(a, b), _mm_set1_epi16(1));
+    return _mm_add_epi16(_mm_add_epi16(_mm_srai_epi16(a, 1),
+                                       _mm_srai_epi16(b, 1)),
+                         carry);
+  }
+  static inline __m128i HalfSub16(const __m128i a, const __m128i b) {
+    const __m128i borrow =
+        _mm_and_si128(_mm_andnot_si128(a, b), _mm_set1_epi16(1));
+    return _mm_sub_epi16(_mm_sub_epi16(_mm_srai_epi16(a, 1),
+                                       _mm_srai_epi16(b, 1)),
+                         borrow);
+  }
+
+  static inline Complex HalfAdd(const Complex a, const Complex b) {
+    return HalfAdd16(a, b);
+  }
+  static inline Complex HalfSubConj(const Complex a, const Complex b) {
+    const __m128i real_mask = _mm_set1_epi32(0xFFFF);
+    return _mm_or_si128(_mm_and_si128(HalfSub16(a, b), real_mask),
+                        _mm_andnot_si128(real_mask, HalfSub16(b, a)));
+  }
+
+  // Transposes four rows of four 32-bit complex values.
+  static inline void Transpose(__m128i* r0, __m128i* r1, __m128i* r2,
+                               __m128i* r3) {
+    const __m128i t0 = _mm_unpacklo_epi32(*r0, *r1);
+    const __m128i t1 = _mm_unpacklo_epi32(*r2, *r3);
+    const __m128i t2 = _mm_unpackhi_epi32(*r0, *r1);
+    const __m128i t3 = _mm_unpackhi_epi32(*r2, *r3);
+    *r0 = _mm_unpacklo_epi64(t0, t1);
+    *r1 = _mm_unpackhi_epi64(t0, t1);
+    *r2 = _mm_unpacklo_epi64(t2, t3);
+    *r3 = _mm_unpackhi_epi64(t2, t3);
+  }
+};
+#endif  // FFT_POW2_USE_SSE2
+
+#ifdef FFT_POW2_USE_AVX2
+// Eight consecutive complex values per register.
+struct Avx2Ops {
+  typedef __m256i Complex;
+  struct Twiddle {
+    __m256i real;
+    __m256i imag;
+  };
+  static const int kWidth = 8;
+
+  static inline Complex Load(const struct complex_int16_t* p) {
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+  }
+  static inline void Store(struct complex_int16_t* p, Complex a) {
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), a);
+  }
+
+  static inline __m256i Swap(const __m256i a) {
+    return _mm256_shufflehi_epi16(
+        _mm256_shufflelo_epi16(a, _MM_SHUFFLE(2, 3, 0, 1)),
+        _MM_SHUFFLE(2, 3, 0, 1));
+  }
+  static inline __m256i Reverse(const __m256i a) {
+    return _mm256_permutevar8x32_epi32(a,
+                                       _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0));
+  }
+
+  static inline Twiddle MakeTwiddle(const __m256i b) {
+    Twiddle tw;
+    tw.real = Conj(b);
+    tw.imag = Swap(b);
+    return tw;
+  }
+  static inline Twiddle LoadTwiddle(const struct complex_int16_t* p) {
+    return MakeTwiddle(Load(p));
+  }
+
+  template <int kDiv>
+  static inline Complex FixDiv(const Complex a) {
+    return _mm256_mulhrs_epi16(a, _mm256_set1_epi16(kSampMax / kDiv));
+  }
+
+  static inline Complex Mul(const Complex a, const Twiddle& b) {
+    const __m256i round = _mm256_set1_epi32(1 << 14);
+    const __m256i real = _mm256_srai_epi32(
+        _mm256_add_epi32(_mm256_madd_epi16(a, b.real), round), 15);
+    const __m256i imag = _mm256_srai_epi32(
+        _mm256_add_epi32(_mm256_madd_epi16(a, b.imag), round), 15);
+    return _mm256_blend_epi16(real, _mm256_slli_epi32(imag, 16), 0xAA);
+  }
+
+  static inline Complex Add(const Complex a, const Complex b) {
+    return _mm256_add_epi16(a, b);
+  }
+  static inline Complex Sub(const Complex a, const Complex b) {
+    return _mm256_sub_epi16(a, b);
+  }
+
+  static inline Complex Conj(const Complex a) {
+    return _mm256_blend_epi16(a, _mm256_sub_epi16(_mm256_setzero_si256(), a),
+                              0xAA);
+  }
+  static inline Complex MulMinusI(const Complex a) { return Conj(Swap(a)); }
+
+  static inline __m256i HalfAdd16(const __m256i a, const __m256i b) {
+    const __m256i carry =
+        _mm256_and_si256(_mm256_and_si256(a, b), _mm256_set1_epi16(1));
+    return _mm256_add_epi16(_mm256_add_epi16(_mm256_srai_epi16(a, 1),
+                                             _mm256_srai_epi16(b, 1)),
+                            carry);
+  }
+  static inline __m256i HalfSub16(const __m256i a, const __m256i b) {
+    const __m256i borrow =
+        _mm256_and_si256(_mm256_andnot_si256(a, b), _mm256_set1_epi16(1));
+    return _mm256_sub_epi16(_mm256_sub_epi16(_mm256_srai_epi16(a, 1),
+                                             _mm256_srai_epi16(b, 1)),
+                            borrow);
+  }
+
+  static inline Complex HalfAdd(const Complex a, const Complex b) {
+    return HalfAdd16(a, b);
+  }
+  static inline Complex HalfSubConj(const Complex a, const Complex b) {
+    return _mm256_blend_epi16(HalfSub16(a, b), HalfSub16(b, a), 0xAA);
+  }
+};
+#endif  // FFT_POW2_USE_AVX2
+
+#ifdef FFT_POW2_USE_AVX512
+// Sixteen consecutive complex values per register.
+struct Avx512Ops {
+  typedef __m512i Complex;
+  struct Twiddle {
+    __m512i real;
+    __m512i imag;
+  };
+  static const int kWidth = 16;
+  // Selects the imaginary parts in the 16-bit mask ops.
+  static const __mmask32 kImagMask = 0xAAAAAAAA;
+
+  static inline Complex Load(const struct complex_int16_t* p) {
+    return _mm512_loadu_si512(p);
+  }
+  static inline void Store(struct complex_int16_t* p, Complex a) {
+    _mm512_storeu_si512(p, a);
+  }
+
+  static inline __m512i Swap(const __m512i a) {
+    return _mm512_shufflehi_epi16(
+        _mm512_shufflelo_epi16(a, _MM_SHUFFLE(2, 3, 0, 1)),
+        _MM_SHUFFLE(2, 3, 0, 1));
+  }
+  static inline __m512i Reverse(const __m512i a) {
+    return _mm512_permutexvar_epi32(
+        _mm512_setr_epi32(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1,
+                          0),
+        a);
+  }
+
+  static inline Twiddle MakeTwiddle(const __m512i b) {
+    Twiddle tw;
+    tw.real = Conj(b);
+    tw.imag = Swap(b);
+    return tw;
+  }
+  static inline Twiddle LoadTwiddle(const struct complex_int16_t* p) {
+    return MakeTwiddle(Load(p));
+  }
+
+  template <int kDiv>
+  static inline Complex FixDiv(const Complex a) {
+    return _mm512_mulhrs_epi16(a, _mm512_set1_epi16(kSampMax / kDiv));
+  }
+
+  static inline Complex Mul(const Complex a, const Twiddle& b) {
+    const __m512i round = _mm512_set1_epi32(1 << 14);
+    const __m512i real = _mm512_srai_epi32(
+        _mm512_add_epi32(_mm512_madd_epi16(a, b.real), round), 15);
+    const __m512i imag = _mm512_srai_epi32(
+        _mm512_add_epi32(_mm512_madd_epi16(a, b.imag), round), 15);
+    return _mm512_mask_blend_epi16(kImagMask, real,
+                                   _mm512_slli_epi32(imag, 16));
+  }
+
+  static inline Complex Add(const Complex a, const Complex b) {
+    return _mm512_add_epi16(a, b);
+  }
+  static inline Complex Sub(const Complex a, const Complex b) {
+    return _mm512_sub_epi16(a, b);
+  }
+
+  static inline Complex Conj(const Complex a) {
+    return _mm512_mask_sub_epi16(a, kImagMask, _mm512_setzero_si512(), a);
+  }
+  static inline Complex MulMinusI(const Complex a) { return Conj(Swap(a)); }
+
+  static inline __m512i HalfAdd16(const __m512i a, const __m512i b) {
+    const __m512i carry =
+        _mm512_and_si512(_mm512_and_si512(a, b), _mm512_set1_epi16(1));
+    return _mm512_add_epi16(_mm512_add_epi16(_mm512_srai_epi16(a, 1),
+                                             _mm512_srai_epi16(b, 1)),
+                            carry);
+  }
+  static inline __m512i HalfSub16(const __m512i a, const __m512i b) {
+    const __m512i borrow =
+        _mm512_and_si512(_mm512_andnot_si512(a, b), _mm512_set1_epi16(1));
+    return _mm512_sub_epi16(_mm512_sub_epi16(_mm512_srai_epi16(a, 1),
+                                             _mm512_srai_epi16(b, 1)),
+                            borrow);
+  }
+
+  static inline Complex HalfAdd(const Complex a, const Complex b) {
+    return HalfAdd16(a, b);
+  }
+  static inline Complex HalfSubConj(const Complex a, const Complex b) {
+    return _mm512_mask_blend_epi16(kImagMask, HalfSub16(a, b),
+                                   HalfSub16(b, a));
+  }
+};
+#endif  // FFT_POW2_USE_AVX512
+
+// The lane ops below hold one complex value of several independent streams,
+// with the real parts in one register and the imaginary parts in another.
+// Storage is a block of kLanes real parts followed by kLanes imaginary parts.
+
+#ifdef FFT_POW2_USE_SSE2
+struct Sse2LaneOps {
+  static const int kLanes = 8;
+  struct Storage {
+    int16_t real[kLanes];
+    int16_t imag[kLanes];
+  };
+  struct Complex {
+    __m128i real;
+    __m128i imag;
+  };
+  // C_MUL operands for _mm_madd_epi16, broadcast to every stream.
+  struct Twiddle {
+    __m128i real;
+    __m128i imag;
+  };
+
+  static inline Complex Load(const Storage* p) {
+    Complex a;
+    a.real = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p->real));
+    a.imag = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p->imag));
+    return a;
+  }
+  static inline void Store(Storage* p, const Complex& a) {
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(p->real), a.real);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(p->imag), a.imag);
+  }
+  static inline Twiddle LoadTwiddle(const struct complex_int16_t* p) {
+    const uint16_t br = static_cast<uint16_t>(p->real);
+    const uint16_t bi = static_cast<uint16_t>(p->imag);
+    const uint16_t neg_bi = static_cast<uint16_t>(-p->imag);
+    Twiddle tw;
+    tw.real = _mm_set1_epi32(static_cast<int>(br | (neg_bi << 16)));
+    tw.imag = _mm_set1_epi32(static_cast<int>(bi | (br << 16)));
+    return tw;
+  }
+
+  template <int kDiv>
+  static inline Complex FixDiv(const Complex& a) {
+    Complex m;
+    m.real = Sse2Ops::FixDiv<kDiv>(a.real);
+    m.imag = Sse2Ops::FixDiv<kDiv>(a.imag);
+    return m;
+  }
+
+  // sround() of four 32-bit sums per half, truncated to 16 bits: bits 15..30
+  // of x + 2^14 are moved to the top half and sign-extended down.
+  static inline __m128i Round15(const __m128i lo, const __m128i hi) {
+    const __m128i round = _mm_set1_epi32(1 << 14);
+    return _mm_packs_epi32(
+        _mm_srai_epi32(_mm_slli_epi32(_mm_add_epi32(lo, round), 1), 16),
+        _mm_srai_epi32(_mm_slli_epi32(_mm_add_epi32(hi, round), 1), 16));
+  }
+
+  static inline Complex Mul(const Complex& a, const Twiddle& b) {
+    const __m128i lo = _mm_unpacklo_epi16(a.real, a.imag);
+    const __m128i hi = _mm_unpackhi_epi16(a.real, a.imag);
+    Complex m;
+    m.real = Round15(_mm_madd_epi16(lo, b.real), _mm_madd_epi16(hi, b.real));
+    m.imag = Round15(_mm_madd_epi16(lo, b.imag), _mm_madd_epi16(hi, b.imag));
+    return m;
+  }
+
+  static inline Complex Add(const Complex& a, const Complex& b) {
+    Complex m;
+    m.real = _mm_add_epi16(a.real, b.real);
+    m.imag = _mm_add_epi16(a.imag, b.imag);
+    return m;
+  }
+  static inline Complex Sub(const Complex& a, const Complex& b) {
+    Complex m;
+    m.real = _mm_sub_epi16(a.real, b.real);
+    m.imag = _mm_sub_epi16(a.imag, b.imag);
+    return m;
+  }
+  static inline Complex MulMinusI(const Complex& a) {
+    Complex m;
+    m.real = a.imag;
+    m.imag = _mm_sub_epi16(_mm_setzero_si128(), a.real);
+    return m;
+  }
+  static inline Complex Conj(const Complex& a) {
+    Complex m;
+    m.real = a.real;
+    m.imag = _mm_sub_epi16(_mm_setzero_si128(), a.imag);
+    return m;
+  }
+  static inline Complex HalfAdd(const Complex& a, const Complex& b) {
+    Complex m;
+    m.real = Sse2Ops::HalfAdd16(a.real, b.real);
+    m.imag = Sse2Ops::HalfAdd16(a.imag, b.imag);
+    return m;
+  }
+  static inline Complex HalfSubConj(const Complex& a, const Complex& b) {
+    Complex m;
+    m.real = Sse2Ops::HalfSub16(a.real, b.real);
+    m.imag = Sse2Ops::HalfSub16(b.imag, a.imag);
+    return m;
+  }
+
+  // The DC and Nyquist bins of the real split: (re + im, 0) and (re - im, 0)
+  // of the halved first bin.
+  static inline void SplitDc(const Complex& tdc, Complex* dc,
+                             Complex* nyquist) {
+    dc->real = _mm_add_epi16(tdc.real, tdc.imag);
+    dc->imag = _mm_setzero_si128();
+    nyquist->real = _mm_sub_epi16(tdc.real, tdc.imag);
+    nyquist->imag = _mm_setzero_si128();
+  }
+};
+
+// Transposes an 8x8 block of int16_t held in eight registers.
+inline void Transpose8x8(__m128i* r) {
+  const __m128i a0 = _mm_unpacklo_epi16(r[0], r[1]);
+  const __m128i a1 = _mm_unpackhi_epi16(r[0], r[1]);
+  const __m128i a2 = _mm_unpacklo_epi16(r[2], r[3]);
+  const __m128i a3 = _mm_unpackhi_epi16(r[2], r[3]);
+  const __m128i a4 = _mm_unpacklo_epi16(r[4], r[5]);
+  const __m128i a5 = _mm_unpackhi_epi16(r[4], r[5]);
+  const __m128i a6 = _mm_unpacklo_epi16(r[6], r[7]);
+  const __m128i a7 = _mm_unpackhi_epi16(r[6], r[7]);
+  const __m128i b0 = _mm_unpacklo_epi32(a0, a2);
+  const __m128i b1 = _mm_unpackhi_epi32(a0, a2);
+  const __m128i b2 = _mm_unpacklo_epi32(a1, a3);
+  const __m128i b3 = _mm_unpackhi_epi32(a1, a3);
+  const __m128i b4 = _mm_unpacklo_epi32(a4, a6);
+  const __m128i b5 = _mm_unpackhi_epi32(a4, a6);
+  const __m128i b6 = _mm_unpacklo_epi32(a5, a7);
+  const __m128i b7 = _mm_unpackhi_epi32(a5, a7);
+  r[0] = _mm_unpacklo_epi64(b0, b4);
+  r[1] = _mm_unpackhi_epi64(b0, b4);
+  r[2] = _mm_unpacklo_epi64(b1, b5);
+  r[3] = _mm_unpackhi_epi64(b1, b5);
+  r[4] = _mm_unpacklo_epi64(b2, b6);
+  r[5] = _mm_unpackhi_epi64(b2, b6);
+  r[6] = _mm_unpacklo_epi64(b3, b7);
+  r[7] = _mm_unpackhi_epi64(b3, b7);
+}
+#endif  // FFT_POW2_USE_SSE2
+
+#ifdef FFT_POW2_USE_AVX2
+struct Avx2LaneOps {
+  static const int kLanes = 16;
+  struct Storage {
+    int16_t real[kLanes];
+    int16_t imag[kLanes];
+  };
+  struct Complex {
+    __m256i real;
+    __m256i imag;
+  };
+  struct Twiddle {
+    __m256i real;
+    __m256i imag;
+  };
+
+  static inline Complex Load(const Storage* p) {
+    Complex a;
+    a.real = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p->real));
+    a.imag = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p->imag));
+    return a;
+  }
+  static inline void Store(Storage* p, const Complex& a) {
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(p->real), a.real);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(p->imag), a.imag);
+  }
+  static inline Twiddle LoadTwiddle(const struct complex_int16_t* p) {
+    const uint16_t br = static_cast<uint16_t>(p->real);
+    const uint16_t bi = static_cast<uint16_t>(p->imag);
+    const uint16_t neg_bi = static_cast<uint16_t>(-p->imag);
+    Twiddle tw;
+    tw.real = _mm256_set1_epi32(static_cast<int>(br | (neg_bi << 16)));
+    tw.imag = _mm256_set1_epi32(static_cast<int>(bi | (br << 16)));
+    return tw;
+  }
+
+  template <int kDiv>
+  static inline Complex FixDiv(const Complex& a) {
+    Complex m;
+    m.real = Avx2Ops::FixDiv<kDiv>(a.real);
+    m.imag = Avx2Ops::FixDiv<kDiv>(a.imag);
+    return m;
+  }
+
+  // The unpacks and the pack both work within 128-bit halves, so the stream
+  // order comes back unchanged.
+  static inline __m256i Round15(const __m256i lo, const __m256i hi) {
+    const __m256i round = _mm256_set1_epi32(1 << 14);
+    return _mm256_packs_epi32(
+        _mm256_srai_epi32(_mm256_slli_epi32(_mm256_add_epi32(lo, round), 1),
+                          16),
+        _mm256_srai_epi32(_mm256_slli_epi32(_mm256_add_epi32(hi, round), 1),
+                          16));
+  }
+
+  static inline Complex Mul(const Complex& a, const Twiddle& b) {
+    const __m256i lo = _mm256_unpacklo_epi16(a.real, a.imag);
+    const __m256i hi = _mm256_unpackhi_epi16(a.real, a.imag);
+    Complex m;
+    m.real = Round15(_mm256_madd_epi16(lo, b.real),
+                     _mm256_madd_epi16(hi, b.real));
+    m.imag = Round15(_mm256_madd_epi16(lo, b.imag),
+                     _mm256_madd_epi16(hi, b.imag));
+    return m;
+  }
+
+  static inline Complex Add(const Complex& a, const Complex& b) {
+    Complex m;
+    m.real = _mm256_add_epi16(a.real, b.real);
+    m.imag = _mm256_add_epi16(a.imag, b.imag);
+    return m;
+  }
+  static inline Complex Sub(const Complex& a, const Complex& b) {
+    Complex m;
+    m.real = _mm256_sub_epi16(a.real, b.real);
+    m.imag = _mm256_sub_epi16(a.imag, b.imag);
+    return m;
+  }
+  static inline Complex MulMinusI(const Complex& a) {
+    Complex m;
+    m.real = a.imag;
+    m.imag = _mm256_sub_epi16(_mm256_setzero_si256(), a.real);
+    return m;
+  }
+  static inline Complex Conj(const Complex& a) {
+    Complex m;
+    m.real = a.real;
+    m.imag = _mm256_sub_epi16(_mm256_setzero_si256(), a.imag);
+    return m;
+  }
+  static inline Complex HalfAdd(const Complex& a, const Complex& b) {
+    Complex m;
+    m.real = Avx2Ops::HalfAdd16(a.real, b.real);
+    m.imag = Avx2Ops::HalfAdd16(a.imag, b.imag);
+    return m;
+  }
+  static inline Complex HalfSubConj(const Complex& a, const Complex& b) {
+    Complex m;
+    m.real = Avx2Ops::HalfSub16(a.real, b.real);
+    m.imag = Avx2Ops::HalfSub16(b.imag, a.imag);
+    return m;
+  }
+
+  static inline void SplitDc(const Complex& tdc, Complex* dc,
+                             Complex* nyquist) {
+    dc->real = _mm256_add_epi16(tdc.real, tdc.imag);
+    dc->imag = _mm256_setzero_si256();
+    nyquist->real = _mm256_sub_epi16(tdc.real, tdc.imag);
+    nyquist->imag = _mm256_setzero_si256();
+  }
+};
+#endif  // FFT_POW2_USE_AVX2
+
+// Stands in for the first twiddle of every stage, exp(0), which kissfft
+// quantizes to (32767, 0). C_MUL by it only rounds each part, which is
+// C_FIXDIV(a, 1), so the multiply-adds can be skipped.
+struct UnitTwiddle {};
+
+template <class Ops>
+inline typename Ops::Complex MulTwiddle(const typename Ops::Complex& a,
+                                        const typename Ops::Twiddle& tw) {
+  return Ops::Mul(a, tw);
+}
+
+template <class Ops>
+inline typename Ops::Complex MulTwiddle(const typename Ops::Complex& a,
+                                        UnitTwiddle) {
+  return Ops::template FixDiv<1>(a);
+}
+
+// kf_bfly2() for one butterfly (or one register of them).
+template <class Ops, class Twiddle>
+inline void Butterfly2(typename Ops::Complex* f0, typename Ops::Complex* f1,
+                       const Twiddle& tw) {
+  const typename Ops::Complex a = Ops::template FixDiv<2>(*f0);
+  const typename Ops::Complex t =
+      MulTwiddle<Ops>(Ops::template FixDiv<2>(*f1), tw);
+  *f1 = Ops::Sub(a, t);
+  *f0 = Ops::Add(a, t);
+}
+
+// kf_bfly4() (forward direction) for one butterfly (or one register of them).
+template <class Ops, class Twiddle>
+inline void Butterfly4(typename Ops::Complex* f0, typename Ops::Complex* f1,
+                       typename Ops::Complex* f2, typename Ops::Complex* f3,
+                       const Twiddle& tw1, const Twiddle& tw2,
+                       const Twiddle& tw3) {
+  typedef typename Ops::Complex Complex;
+  Complex a0 = Ops::template FixDiv<4>(*f0);
+  const Complex s0 = MulTwiddle<Ops>(Ops::template FixDiv<4>(*f1), tw1);
+  const Complex s1 = MulTwiddle<Ops>(Ops::template FixDiv<4>(*f2), tw2);
+  const Complex s2 = MulTwiddle<Ops>(Ops::template FixDiv<4>(*f3), tw3);
+
+  const Complex s5 = Ops::Sub(a0, s1);
+  a0 = Ops::Add(a0, s1);
+  const Complex s3 = Ops::Add(s0, s2);
+  const Complex s4 = Ops::MulMinusI(Ops::Sub(s0, s2));
+  *f2 = Ops::Sub(a0, s3);
+  *f0 = Ops::Add(a0, s3);
+  *f1 = Ops::Add(s5, s4);
+  *f3 = Ops::Sub(s5, s4);
+}
+
+// kf_bfly2() with the unit twiddle, for an innermost stage whose legs from
+// kLiveLegs on are known to be zero (the zero padding at the end of the
+// input). Skipping their arithmetic does not change the result.
+template <class Ops, int kLiveLegs>
+inline void LeafButterfly2(typename Ops::Complex* f0,
+                           typename Ops::Complex* f1) {
+  if (kLiveLegs >= 2) {
+    Butterfly2<Ops>(f0, f1, UnitTwiddle());
+    return;
+  }
+  *f0 = Ops::template FixDiv<2>(*f0);
+  *f1 = *f0;
+}
+
+// kf_bfly4() with unit twiddles and legs from kLiveLegs on known to be zero.
+template <class Ops, int kLiveLegs>
+inline void LeafButterfly4(typename Ops::Complex* f0, typename Ops::Complex* f1,
+                           typename Ops::Complex* f2,
+                           typename Ops::Complex* f3) {
+  typedef typename Ops::Complex Complex;
+  if (kLiveLegs >= 4) {
+    Butterfly4<Ops>(f0, f1, f2, f3, UnitTwiddle(), UnitTwiddle(),
+                    UnitTwiddle());
+    return;
+  }
+  const Complex a0 = Ops::template FixDiv<4>(*f0);
+  if (kLiveLegs <= 1) {
+    *f0 = a0;
+    *f1 = a0;
+    *f2 = a0;
+    *f3 = a0;
+    return;
+  }
+  const Complex s0 = MulTwiddle<Ops>(Ops::template FixDiv<4>(*f1),
+                                     UnitTwiddle());
+  const Complex s4 = Ops::MulMinusI(s0);
+  if (kLiveLegs == 2) {
+    *f0 = Ops::Add(a0, s0);
+    *f1 = Ops::Add(a0, s4);
+    *f2 = Ops::Sub(a0, s0);
+    *f3 = Ops::Sub(a0, s4);
+    return;
+  }
+  const Complex s1 = MulTwiddle<Ops>(Ops::template FixDiv<4>(*f2),
+                                     UnitTwiddle());
+  const Complex s5 = Ops::Sub(a0, s1);
+  const Complex a1 = Ops::Add(a0, s1);
+  *f0 = Ops::Add(a1, s0);
+  *f1 = Ops::Add(s5, s4);
+  *f2 = Ops::Sub(a1, s0);
+  *f3 = Ops::Sub(s5, s4);
+}
+
+// One step of the real-input split at the end of kiss_fftr(): turns bins k
+// and ncfft - k of the half-size complex transform into the same bins of the
+// real spectrum.
+template <class Ops>
+inline void RealSplitPair(typename Ops::Complex* bin_k,
+                          typename Ops::Complex* bin_nk,
+                          const typename Ops::Twiddle& super_twiddle) {
+  typedef typename Ops::Complex Complex;
+  const Complex fpk = Ops::template FixDiv<2>(*bin_k);
+  const Complex fpnk = Ops::template FixDiv<2>(Ops::Conj(*bin_nk));
+  const Complex f1k = Ops::Add(fpk, fpnk);
+  const Complex tw = Ops::Mul(Ops::Sub(fpk, fpnk), super_twiddle);
+  *bin_k = Ops::HalfAdd(f1k, tw);
+  *bin_nk = Ops::HalfSubConj(f1k, tw);
+}
+
+}  // namespace FFT_POW2_TIER
+}  // namespace fft_pow2
+
+#endif  // TENSORFLOW_LITE_EXPERIMENTAL_MICROFRONTEND_LIB_FFT_POW2_KERNELS_H_
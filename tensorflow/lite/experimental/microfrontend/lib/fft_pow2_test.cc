@@ -0,0 +1,189 @@
+/* Copyright 2026 The pymicro-features Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tensorflow/lite/experimental/microfrontend/lib/fft_pow2.h"
+
+#include "tensorflow/lite/experimental/microfrontend/lib/cpu_features.h"
+#include "tensorflow/lite/experimental/microfrontend/lib/fft_backend.h"
+#include "tensorflow/lite/experimental/microfrontend/lib/fft_util.h"
+#include "tensorflow/lite/experimental/microfrontend/lib/kiss_fft_int16.h"
+#include "tensorflow/lite/micro/testing/micro_test.h"
+
+namespace {
+
+const int kNumTrials = 8;
+
+uint32_t NextRandom(uint32_t* seed) {
+  *seed = *seed * 1664525u + 1013904223u;
+  return *seed >> 16;
+}
+
+// Fills input with full-scale noise, alternating extremes or a quiet signal,
+// so both the wrap-around and the rounding paths of the transform get hit.
+void FillInput(int trial, uint32_t* seed, int16_t* input, size_t size) {
+  size_t i;
+  for (i = 0; i < size; ++i) {
+    switch (trial % 4) {
+      case 0:
+        input[i] = static_cast<int16_t>(NextRandom(seed));
+        break;
+      case 1:
+        input[i] = (NextRandom(seed) & 1) ? 32767 : -32768;
+        break;
+      case 2:
+        input[i] = static_cast<int16_t>(NextRandom(seed) % 33) - 16;
+        break;
+      default:
+        input[i] = (i & 1) ? -32768 : 32767;
+        break;
+    }
+  }
+}
+
+}  // namespace
+
+TF_LITE_MICRO_TESTS_BEGIN
+
+TF_LITE_MICRO_TEST(FftPow2Test_MatchesKissFft) {
+  const int active_tier = CpuActiveTier();
+  uint32_t seed = 1;
+  int log2_size;
+  for (log2_size = kFftPow2MinLog2Size; log2_size <= kFftPow2MaxLog2Size;
+       ++log2_size) {
+    const size_t fft_size = (size_t)1 << log2_size;
+    struct FftPow2Plan plan;
+    TF_LITE_MICRO_EXPECT(FftPow2PopulatePlan(&plan, fft_size));
+
+    size_t scratch_size = 0;
+    kissfft_fixed16::kiss_fftr_alloc(fft_size, 0, nullptr, &scratch_size);
+    void* scratch = malloc(scratch_size);
+    kissfft_fixed16::kiss_fftr_cfg kfft_cfg = kissfft_fixed16::kiss_fftr_alloc(
+        fft_size, 0, scratch, &scratch_size);
+    TF_LITE_MICRO_EXPECT(kfft_cfg != nullptr);
+
+    int16_t* input = reinterpret_cast<int16_t*>(malloc(fft_size * 2));
+    struct complex_int16_t* expected =
+        reinterpret_cast<struct complex_int16_t*>(
+            malloc((fft_size / 2 + 1) * sizeof(struct complex_int16_t)));
+    struct complex_int16_t* output =
+        reinterpret_cast<struct complex_int16_t*>(
+            malloc((fft_size / 2 + 1) * sizeof(struct complex_int16_t)));
+
+    int trial;
+    for (trial = 0; trial < kNumTrials; ++trial) {
+      FillInput(trial, &seed, input, fft_size);
+      kissfft_fixed16::kiss_fftr(
+          kfft_cfg, input,
+          reinterpret_cast<kissfft_fixed16::kiss_fft_cpx*>(expected));
+      // Every tier this CPU supports gives kissfft's results.
+      int tier;
+      for (tier = 0; tier <= CpuDetectTier(); ++tier) {
+        TF_LITE_MICRO_EXPECT(CpuSetTier(tier));
+        FftPow2Compute(&plan, input, output);
+
+        size_t i;
+        for (i = 0; i <= fft_size / 2; ++i) {
+          TF_LITE_MICRO_EXPECT_EQ(output[i].real, expected[i].real);
+          TF_LITE_MICRO_EXPECT_EQ(output[i].imag, expected[i].imag);
+        }
+      }
+    }
+
+    free(input);
+    free(expected);
+    free(output);
+    free(scratch);
+    FftPow2FreePlanContents(&plan);
+  }
+  CpuSetTier(active_tier);
+}
+
+TF_LITE_MICRO_TEST(FftPow2Test_ComputeBinsMatchesKissFft) {
+  const int active_tier = CpuActiveTier();
+  uint32_t seed = 3;
+  int log2_size;
+  for (log2_size = kFftPow2MinLog2Size; log2_size <= kFftPow2MaxLog2Size;
+       ++log2_size) {
+    const size_t fft_size = (size_t)1 << log2_size;
+    const size_t num_bins = fft_size / 2 + 1;
+    struct FftPow2Plan plan;
+    TF_LITE_MICRO_EXPECT(FftPow2PopulatePlan(&plan, fft_size));
+
+    size_t scratch_size = 0;
+    kissfft_fixed16::kiss_fftr_alloc(fft_size, 0, nullptr, &scratch_size);
+    void* scratch = malloc(scratch_size);
+    kissfft_fixed16::kiss_fftr_cfg kfft_cfg = kissfft_fixed16::kiss_fftr_alloc(
+        fft_size, 0, scratch, &scratch_size);
+
+    int16_t* input = reinterpret_cast<int16_t*>(malloc(fft_size * 2));
+    struct complex_int16_t* expected =
+        reinterpret_cast<struct complex_int16_t*>(
+            malloc(num_bins * sizeof(struct complex_int16_t)));
+    struct complex_int16_t* output =
+        reinterpret_cast<struct complex_int16_t*>(
+            malloc(num_bins * sizeof(struct complex_int16_t)));
+
+    int trial;
+    for (trial = 0; trial < 4 * kNumTrials; ++trial) {
+      // Zero padding past a random input size, and a random range of bins.
+      const size_t input_size = NextRandom(&seed) % (fft_size + 1);
+      FillInput(trial, &seed, input, input_size);
+      size_t i;
+      for (i = input_size; i < fft_size; ++i) {
+        input[i] = 0;
+      }
+      size_t start_index = NextRandom(&seed) % num_bins;
+      size_t end_index = NextRandom(&seed) % (num_bins + 1);
+      if (start_index > end_index) {
+        const size_t tmp = start_index;
+        start_index = end_index;
+        end_index = tmp;
+      }
+      kissfft_fixed16::kiss_fftr(
+          kfft_cfg, input,
+          reinterpret_cast<kissfft_fixed16::kiss_fft_cpx*>(expected));
+      int tier;
+      for (tier = 0; tier <= CpuDetectTier(); ++tier) {
+        TF_LITE_MICRO_EXPECT(CpuSetTier(tier));
+        FftPow2ComputeBins(&plan, input, input_size, output, start_index,
+                           end_index);
+
+        for (i = start_index; i < end_index; ++i) {
+          TF_LITE_MICRO_EXPECT_EQ(output[i].real, expected[i].real);
+          TF_LITE_MICRO_EXPECT_EQ(output[i].imag, expected[i].imag);
+        }
+      }
+    }
+
+    free(input);
+    free(expected);
+    free(output);
+    free(scratch);
+    FftPow2FreePlanContents(&plan);
+  }
+  CpuSetTier(active_tier);
+}
+
+TF_LITE_MICRO_TEST(FftPow2Test_SelectedForPowerOfTwoSizes) {
+  struct FftState state;
+  TF_LITE_MICRO_EXPECT(FftPopulateState(&state, 480));
+  TF_LITE_MICRO_EXPECT_EQ(state.fft_size, static_cast<size_t>(512));
+  TF_LITE_MICRO_EXPECT(state.backend == &kFftPow2Backend);
+  FftFreeStateContents(&state);
+
+  TF_LITE_MICRO_EXPECT(!FftPow2Supported(1 << (kFftPow2MaxLog2Size + 1)));
+  TF_LITE_MICRO_EXPECT(!FftPow2Supported(480));
+}
+
+TF_LITE_MICRO_TESTS_END
@@ -16,14 +16,25 @@ limitations under the License.
 
 #include <stdio.h>
 
-#include "tensorflow/lite/experimental/microfrontend/lib/kiss_fft_int16.h"
+#include "tensorflow/lite/experimental/microfrontend/lib/fft_backend.h"
 
 int FftPopulateState(struct FftState* state, size_t input_size) {
+  return FftPopulateStateWithBackend(state, input_size, nullptr);
+}
+
+int FftPopulateStateWithBackend(struct FftState* state, size_t input_size,
+                                const char* backend_name) {
   state->input_size = input_size;
+  state->scratch = nullptr;
+  state->scratch_size = 0;
+  state->backend = nullptr;
+  state->plan = nullptr;
   state->fft_size = 1;
   while (state->fft_size < state->input_size) {
     state->fft_size <<= 1;
   }
+  state->output_start_index = 0;
+  state->output_end_index = state->fft_size / 2 + 1;
 
   state->input = reinterpret_cast<int16_t*>(
       malloc(state->fft_size * sizeof(*state->input)));
@@ -39,25 +50,35 @@ int FftPopulateState(struct FftState* state, size_t input_size) {
     return 0;
   }
 
-  // Ask kissfft how much memory it wants.
-  size_t scratch_size = 0;
-  kissfft_fixed16::kiss_fftr_cfg kfft_cfg = kissfft_fixed16::kiss_fftr_alloc(
-      state->fft_size, 0, nullptr, &scratch_size);
-  if (kfft_cfg != nullptr) {
-    fprintf(stderr, "Kiss memory sizing failed.\n");
-    return 0;
+  if (backend_name == nullptr) {
+    state->backend = FftDefaultBackend(state->fft_size);
+    if (state->backend == nullptr) {
+      fprintf(stderr, "No fft backend for size %zu\n", state->fft_size);
+      return 0;
+    }
+  } else {
+    state->backend = FftFindBackend(backend_name);
+    if (state->backend == nullptr) {
+      fprintf(stderr, "Unknown fft backend '%s'\n", backend_name);
+      return 0;
+    }
   }
-  state->scratch = malloc(scratch_size);
-  if (state->scratch == nullptr) {
-    fprintf(stderr, "Failed to alloc fft scratch buffer\n");
-    return 0;
+
+  // Backends with shared plans, like the power-of-two one, need no per-state
+  // memory. kissfft keeps a work buffer inside its config, so each state gets
+  // its own.
+  state->scratch_size = state->backend->plan_size(state->fft_size);
+  if (state->scratch_size > 0) {
+    state->scratch = malloc(state->scratch_size);
+    if (state->scratch == nullptr) {
+      fprintf(stderr, "Failed to alloc fft scratch buffer\n");
+      return 0;
+    }
   }
-  state->scratch_size = scratch_size;
-  // Let kissfft configure the scratch space we just allocated
-  kfft_cfg = kissfft_fixed16::kiss_fftr_alloc(state->fft_size, 0,
-                                              state->scratch, &scratch_size);
-  if (kfft_cfg != state->scratch) {
-    fprintf(stderr, "Kiss memory preallocation strategy failed.\n");
+  state->plan = state->backend->create_plan(state->fft_size, state->scratch);
+  if (state->plan == nullptr) {
+    fprintf(stderr, "Fft backend '%s' does not support size %zu\n",
+            state->backend->name, state->fft_size);
     return 0;
   }
   return 1;
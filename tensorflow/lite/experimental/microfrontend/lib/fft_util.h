@@ -24,6 +24,11 @@ extern "C" {
 // Prepares and FFT for the given input size.
 int FftPopulateState(struct FftState* state, size_t input_size);
 
+// Same as FftPopulateState(), but uses the registered backend with the given
+// name (see fft_backend.h). A NULL name picks FftDefaultBackend().
+int FftPopulateStateWithBackend(struct FftState* state, size_t input_size,
+                                const char* backend_name);
+
 // Frees any allocated buffers.
 void FftFreeStateContents(struct FftState* state);
 
@@ -14,9 +14,11 @@ limitations under the License.
 ==============================================================================*/
 #include "tensorflow/lite/experimental/microfrontend/lib/filterbank.h"
 
+#include <math.h>
 #include <string.h>
 
-#include "tensorflow/lite/experimental/microfrontend/lib/bits.h"
+#include "tensorflow/lite/experimental/microfrontend/lib/cpu_features.h"
+#include "tensorflow/lite/experimental/microfrontend/lib/filterbank_dispatch.h"
 
 void FilterbankConvertFftComplexToEnergy(struct FilterbankState* state,
                                          struct complex_int16_t* fft_output,
@@ -34,28 +36,28 @@ void FilterbankConvertFftComplexToEnergy(struct FilterbankState* state,
   }
 }
 
-void FilterbankAccumulateChannels(struct FilterbankState* state,
-                                  const int32_t* energy) {
+// The scalar kernel, on the packed channel layout. Each energy is read once
+// and multiplied by both the weight of its channel and the unweight that
+// goes to the next one.
+static void AccumulateChannels(struct FilterbankState* state,
+                               const int32_t* energy) {
   uint64_t* work = state->work;
   uint64_t weight_accumulator = 0;
   uint64_t unweight_accumulator = 0;
 
-  const int16_t* channel_frequency_starts = state->channel_frequency_starts;
-  const int16_t* channel_weight_starts = state->channel_weight_starts;
-  const int16_t* channel_widths = state->channel_widths;
-
+  const int16_t* packed = state->packed;
   int num_channels_plus_1 = state->num_channels + 1;
   int i;
   for (i = 0; i < num_channels_plus_1; ++i) {
-    const int32_t* magnitudes = energy + *channel_frequency_starts++;
-    const int16_t* weights = state->weights + *channel_weight_starts;
-    const int16_t* unweights = state->unweights + *channel_weight_starts++;
-    const int width = *channel_widths++;
+    const int32_t* magnitudes = energy + packed[0];
+    const int width = packed[1];
+    packed += 2;
     int j;
     for (j = 0; j < width; ++j) {
-      weight_accumulator += *weights++ * ((uint64_t)*magnitudes);
-      unweight_accumulator += *unweights++ * ((uint64_t)*magnitudes);
-      ++magnitudes;
+      const uint64_t magnitude = (uint64_t)*magnitudes++;
+      weight_accumulator += packed[0] * magnitude;
+      unweight_accumulator += packed[1] * magnitude;
+      packed += 2;
     }
     *work++ = weight_accumulator;
     weight_accumulator = unweight_accumulator;
@@ -63,60 +65,62 @@ void FilterbankAccumulateChannels(struct FilterbankState* state,
   }
 }
 
-static uint16_t Sqrt32(uint32_t num) {
-  if (num == 0) {
-    return 0;
-  }
-  uint32_t res = 0;
-  int max_bit_number = 32 - MostSignificantBit32(num);
-  max_bit_number |= 1;
-  uint32_t bit = 1U << (31 - max_bit_number);
-  int iterations = (31 - max_bit_number) / 2 + 1;
-  while (iterations--) {
-    if (num >= res + bit) {
-      num -= res + bit;
-      res = (res >> 1U) + bit;
-    } else {
-      res >>= 1U;
+// The scalar kernel of FilterbankAccumulateFftChannels(), the same loop with
+// the energies of FilterbankConvertFftComplexToEnergy().
+static void AccumulateFftChannels(struct FilterbankState* state,
+                                  const struct complex_int16_t* fft_output) {
+  uint64_t* work = state->work;
+  uint64_t weight_accumulator = 0;
+  uint64_t unweight_accumulator = 0;
+
+  const int16_t* packed = state->packed;
+  int num_channels_plus_1 = state->num_channels + 1;
+  int i;
+  for (i = 0; i < num_channels_plus_1; ++i) {
+    const struct complex_int16_t* bins = fft_output + packed[0];
+    const int width = packed[1];
+    packed += 2;
+    int j;
+    for (j = 0; j < width; ++j) {
+      const int32_t real = bins->real;
+      const int32_t imag = bins->imag;
+      ++bins;
+      const uint32_t mag_squared =
+          (uint32_t)(real * real) + (uint32_t)(imag * imag);
+      // Sign-extended like the int32_t energies.
+      const uint64_t magnitude = (uint64_t)(int32_t)mag_squared;
+      weight_accumulator += packed[0] * magnitude;
+      unweight_accumulator += packed[1] * magnitude;
+      packed += 2;
     }
-    bit >>= 2U;
-  }
-  // Do rounding - if we have the bits.
-  if (num > res && res != 0xFFFF) {
-    ++res;
+    *work++ = weight_accumulator;
+    weight_accumulator = unweight_accumulator;
+    unweight_accumulator = 0;
   }
-  return res;
 }
 
+// The same rounded square root as the original bit-by-bit loops, without
+// their data-dependent branches: the root of the nearest double is at most
+// one away from the integer one, and is corrected with the remainder.
 static uint32_t Sqrt64(uint64_t num) {
-  // Take a shortcut and just use 32 bit operations if the upper word is all
-  // clear. This will cause a slight off by one issue for numbers close to 2^32,
-  // but it probably isn't going to matter (and gives us a big performance win).
-  if ((num >> 32) == 0) {
-    return Sqrt32((uint32_t)num);
-  }
-  uint64_t res = 0;
-  int max_bit_number = 64 - MostSignificantBit64(num);
-  max_bit_number |= 1;
-  uint64_t bit = 1ULL << (63 - max_bit_number);
-  int iterations = (63 - max_bit_number) / 2 + 1;
-  while (iterations--) {
-    if (num >= res + bit) {
-      num -= res + bit;
-      res = (res >> 1U) + bit;
-    } else {
-      res >>= 1U;
-    }
-    bit >>= 2U;
-  }
-  // Do rounding - if we have the bits.
-  if (num > res && res != 0xFFFFFFFFLL) {
-    ++res;
-  }
-  return res;
+  uint64_t root = (uint64_t)sqrt((double)num);
+  // The double root of numbers close to 2^64 rounds up to 2^32.
+  root -= root >> 32;
+  root -= root * root > num;
+  uint64_t remainder = num - root * root;
+  const uint64_t carry = remainder > 2 * root;
+  remainder -= (0 - carry) & (2 * root + 1);
+  root += carry;
+  // Do rounding - if we have the bits. Numbers with the upper word all clear
+  // keep the limit of the 32 bit shortcut the loops took for them, a 16 bit
+  // root. This causes a slight off by one issue for numbers close to 2^32.
+  root += remainder > root;
+  const uint64_t max_root = (num >> 32) ? 0xFFFFFFFF : 0xFFFF;
+  return root < max_root ? root : max_root;
 }
 
-uint32_t* FilterbankSqrt(struct FilterbankState* state, int scale_down_shift) {
+// The scalar kernel of FilterbankSqrt().
+static void SqrtChannels(struct FilterbankState* state, int scale_down_shift) {
   const int num_channels = state->num_channels;
   const uint64_t* work = state->work + 1;
   // Reuse the work buffer since we're fine clobbering it at this point to hold
@@ -126,6 +130,47 @@ uint32_t* FilterbankSqrt(struct FilterbankState* state, int scale_down_shift) {
   for (i = 0; i < num_channels; ++i) {
     *output++ = Sqrt64(*work++) >> scale_down_shift;
   }
+}
+
+static const struct FilterbankKernelSet kScalarKernels = {
+    AccumulateChannels, AccumulateFftChannels, SqrtChannels};
+
+const struct FilterbankKernelSet* const kFilterbankScalarKernels =
+    &kScalarKernels;
+
+const struct FilterbankKernelSet* FilterbankKernelsForTier(int tier) {
+  return CPU_TIER_SELECT(tier, kFilterbankScalarKernels,
+                         kFilterbankSse41Kernels, kFilterbankAvx2Kernels,
+                         kFilterbankAvx512Kernels);
+}
+
+void FilterbankAccumulateChannels(struct FilterbankState* state,
+                                  const int32_t* energy) {
+  if (state->simd_weights == NULL) {
+    AccumulateChannels(state, energy);
+    return;
+  }
+  FilterbankKernelsForTier(CpuActiveTier())->accumulate_channels(state, energy);
+}
+
+void FilterbankAccumulateFftChannels(struct FilterbankState* state,
+                                     const struct complex_int16_t* fft_output) {
+  if (state->simd_weights == NULL) {
+    AccumulateFftChannels(state, fft_output);
+    return;
+  }
+  FilterbankKernelsForTier(CpuActiveTier())
+      ->accumulate_fft_channels(state, fft_output);
+}
+
+uint32_t* FilterbankSqrt(struct FilterbankState* state, int scale_down_shift) {
+  const struct FilterbankKernelSet* kernels =
+      FilterbankKernelsForTier(CpuActiveTier());
+  if (kernels->sqrt_channels == NULL) {
+    SqrtChannels(state, scale_down_shift);
+  } else {
+    kernels->sqrt_channels(state, scale_down_shift);
+  }
   return (uint32_t*)state->work;
 }
 
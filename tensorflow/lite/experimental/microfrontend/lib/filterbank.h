@@ -22,6 +22,13 @@ limitations under the License.
 
 #define kFilterbankBits 12
 
+// Bins per block of the SIMD channel layout. Every channel's weights start on
+// a block boundary, which keeps them 16-byte aligned.
+#define kFilterbankSimdWidth 8
+
+// Byte alignment of the packed channel layout, one cache line.
+#define kFilterbankPackedAlignment 64
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -36,6 +43,23 @@ struct FilterbankState {
   int16_t* weights;
   int16_t* unweights;
   uint64_t* work;
+  // The same sums for the SIMD kernels, or NULL if the spectrum is too short
+  // for them: work[i] is the dot product of the simd_blocks[i] blocks of
+  // kFilterbankSimdWidth weights at simd_weights (after those of the earlier
+  // entries) with the energies from bin simd_starts[i] on. Its weights are
+  // the unweights of channel i - 1 and then the weights of channel i,
+  // zero padded to whole blocks.
+  int16_t* simd_starts;
+  int16_t* simd_blocks;
+  int16_t* simd_weights;
+  // The channels again for the scalar kernels, packed so that a frame reads
+  // one contiguous stream: for each of the num_channels + 1 channels, the
+  // first bin it covers and its width in bins, then a weight and unweight
+  // pair for each of those bins. Starts on a kFilterbankPackedAlignment
+  // boundary inside packed_buffer, the allocation to free, which is NULL
+  // when the state does not own it.
+  int16_t* packed;
+  void* packed_buffer;
 };
 
 // Converts the relevant complex values of an FFT output into energy (the
@@ -49,6 +73,12 @@ void FilterbankConvertFftComplexToEnergy(struct FilterbankState* state,
 void FilterbankAccumulateChannels(struct FilterbankState* state,
                                   const int32_t* energy);
 
+// Same as FilterbankConvertFftComplexToEnergy() followed by
+// FilterbankAccumulateChannels(), but computes each energy as it is
+// accumulated instead of storing it. The FFT output is left unchanged.
+void FilterbankAccumulateFftChannels(struct FilterbankState* state,
+                                     const struct complex_int16_t* fft_output);
+
 // Applies an integer square root to the 64 bit intermediate values of the
 // filterbank, and returns a pointer to them. Memory will be invalidated the
 // next time FilterbankAccumulateChannels is called.
@@ -0,0 +1,56 @@
+/* Copyright 2026 The pymicro-features Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef TENSORFLOW_LITE_EXPERIMENTAL_MICROFRONTEND_LIB_FILTERBANK_DISPATCH_H_
+#define TENSORFLOW_LITE_EXPERIMENTAL_MICROFRONTEND_LIB_FILTERBANK_DISPATCH_H_
+
+#include <stdint.h>
+
+#include "tensorflow/lite/experimental/microfrontend/lib/cpu_features.h"
+#include "tensorflow/lite/experimental/microfrontend/lib/filterbank.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// The filterbank kernels built for one CPU tier (see cpu_features.h).
+// filterbank.cc holds the scalar set, and filterbank_<tier>.cc the others.
+struct FilterbankKernelSet {
+  // FilterbankAccumulateChannels(). All but the scalar one use the SIMD
+  // channel layout, and need a state that has it.
+  void (*accumulate_channels)(struct FilterbankState* state,
+                              const int32_t* energy);
+  // FilterbankAccumulateFftChannels(), with the same layouts.
+  void (*accumulate_fft_channels)(struct FilterbankState* state,
+                                  const struct complex_int16_t* fft_output);
+  // The square roots of FilterbankSqrt(), on any channel layout. Tiers
+  // without 64-bit lane compares leave it NULL and use the scalar one.
+  void (*sqrt_channels)(struct FilterbankState* state, int scale_down_shift);
+};
+
+extern const struct FilterbankKernelSet* const kFilterbankScalarKernels;
+#ifdef CPU_FEATURES_X86
+extern const struct FilterbankKernelSet* const kFilterbankSse41Kernels;
+extern const struct FilterbankKernelSet* const kFilterbankAvx2Kernels;
+extern const struct FilterbankKernelSet* const kFilterbankAvx512Kernels;
+#endif
+
+// Returns the kernels for the given tier.
+const struct FilterbankKernelSet* FilterbankKernelsForTier(int tier);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif  // TENSORFLOW_LITE_EXPERIMENTAL_MICROFRONTEND_LIB_FILTERBANK_DISPATCH_H_
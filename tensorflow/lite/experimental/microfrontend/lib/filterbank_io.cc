@@ -14,9 +14,8 @@ limitations under the License.
 ==============================================================================*/
 #include "tensorflow/lite/experimental/microfrontend/lib/filterbank_io.h"
 
-static void PrintArray(FILE* fp, const char* name, const int16_t* values,
-                       size_t size) {
-  fprintf(fp, "static int16_t filterbank_%s[] = {", name);
+static void PrintArrayValues(FILE* fp, const int16_t* values, size_t size) {
+  fprintf(fp, "{");
   size_t i;
   for (i = 0; i < size; ++i) {
     fprintf(fp, "%d", values[i]);
@@ -27,6 +26,12 @@ static void PrintArray(FILE* fp, const char* name, const int16_t* values,
   fprintf(fp, "};\n");
 }
 
+static void PrintArray(FILE* fp, const char* name, const int16_t* values,
+                       size_t size) {
+  fprintf(fp, "static int16_t filterbank_%s[] = ", name);
+  PrintArrayValues(fp, values, size);
+}
+
 void FilterbankWriteMemmapPreamble(FILE* fp,
                                    const struct FilterbankState* state) {
   const int num_channels_plus_1 = state->num_channels + 1;
@@ -44,6 +49,28 @@ void FilterbankWriteMemmapPreamble(FILE* fp,
   PrintArray(fp, "weights", state->weights, num_weights);
   PrintArray(fp, "unweights", state->unweights, num_weights);
 
+  if (state->simd_weights != NULL) {
+    PrintArray(fp, "simd_starts", state->simd_starts, num_channels_plus_1);
+    PrintArray(fp, "simd_blocks", state->simd_blocks, num_channels_plus_1);
+    int num_simd_weights = 0;
+    for (i = 0; i < num_channels_plus_1; ++i) {
+      num_simd_weights += state->simd_blocks[i] * kFilterbankSimdWidth;
+    }
+    PrintArray(fp, "simd_weights", state->simd_weights, num_simd_weights);
+  }
+
+  // The packed layout keeps its cache line alignment.
+  int num_packed = 0;
+  for (i = 0; i < num_channels_plus_1; ++i) {
+    num_packed += 2 + 2 * state->packed[num_packed + 1];
+  }
+  fprintf(fp, "static int16_t filterbank_packed[]\n");
+  fprintf(fp, "#ifndef _MSC_VER\n");
+  fprintf(fp, "    __attribute__((aligned(%d)))\n", kFilterbankPackedAlignment);
+  fprintf(fp, "#endif\n");
+  fprintf(fp, "    = ");
+  PrintArrayValues(fp, state->packed, num_packed);
+
   fprintf(fp, "static uint64_t filterbank_work[%d];\n", num_channels_plus_1);
   fprintf(fp, "\n");
 }
@@ -64,4 +91,15 @@ void FilterbankWriteMemmap(FILE* fp, const struct FilterbankState* state,
   fprintf(fp, "%s->weights = filterbank_weights;\n", variable);
   fprintf(fp, "%s->unweights = filterbank_unweights;\n", variable);
   fprintf(fp, "%s->work = filterbank_work;\n", variable);
+  fprintf(fp, "%s->packed = filterbank_packed;\n", variable);
+  fprintf(fp, "%s->packed_buffer = NULL;\n", variable);
+  if (state->simd_weights != NULL) {
+    fprintf(fp, "%s->simd_starts = filterbank_simd_starts;\n", variable);
+    fprintf(fp, "%s->simd_blocks = filterbank_simd_blocks;\n", variable);
+    fprintf(fp, "%s->simd_weights = filterbank_simd_weights;\n", variable);
+  } else {
+    fprintf(fp, "%s->simd_starts = NULL;\n", variable);
+    fprintf(fp, "%s->simd_blocks = NULL;\n", variable);
+    fprintf(fp, "%s->simd_weights = NULL;\n", variable);
+  }
 }
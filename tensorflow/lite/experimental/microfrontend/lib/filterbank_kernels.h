@@ -0,0 +1,309 @@
+/* Copyright 2026 The pymicro-features Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef TENSORFLOW_LITE_EXPERIMENTAL_MICROFRONTEND_LIB_FILTERBANK_KERNELS_H_
+#define TENSORFLOW_LITE_EXPERIMENTAL_MICROFRONTEND_LIB_FILTERBANK_KERNELS_H_
+
+// C++-only SIMD kernels of FilterbankAccumulateChannels() and
+// FilterbankAccumulateFftChannels(), over the padded channel layout of
+// FilterbankState, and of FilterbankSqrt(). The energies are squared
+// magnitudes of up to 2^31 and the weights have 12 bits, so a product needs
+// 43 bits: each lane multiplies the low 32 bits of its energy and weight
+// into a 64-bit product (pmuldq), and the sums stay 64-bit. The multiply
+// sign-extends the energies, as the scalar loop does when one wraps around
+// to a negative int32_t, so the work values are bit-exact with it.
+//
+// The including translation unit defines one of FILTERBANK_USE_SSE41,
+// FILTERBANK_USE_AVX2 and FILTERBANK_USE_AVX512 and names its CPU tier with
+// FILTERBANK_TIER, as fft_pow2_kernels.h does.
+
+#include <stdint.h>
+
+#include "tensorflow/lite/experimental/microfrontend/lib/filterbank.h"
+#include "tensorflow/lite/experimental/microfrontend/lib/filterbank_dispatch.h"
+
+#if defined(FILTERBANK_USE_AVX2) || defined(FILTERBANK_USE_AVX512)
+#include <immintrin.h>
+#else
+#include <smmintrin.h>
+#endif
+
+namespace filterbank {
+inline namespace FILTERBANK_TIER {
+
+// Each policy adds the products of one block of kFilterbankSimdWidth bins to
+// a running sum, and reduces that to a work value.
+#if defined(FILTERBANK_USE_SSE41)
+struct Ops {
+  typedef __m128i Sum;
+
+  static inline Sum Zero() { return _mm_setzero_si128(); }
+
+  // The energies of four bins, either as stored or computed from the FFT
+  // output. _mm_madd_epi16 wraps the one overflowing case, -32768 in both
+  // parts, to INT32_MIN as FilterbankConvertFftComplexToEnergy() does.
+  static inline __m128i Energies(const int32_t* energy) {
+    return _mm_loadu_si128(reinterpret_cast<const __m128i*>(energy));
+  }
+  static inline __m128i Energies(const struct complex_int16_t* fft_output) {
+    const __m128i bins =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(fft_output));
+    return _mm_madd_epi16(bins, bins);
+  }
+
+  // Four bins at a time, the even and the odd ones separately.
+  template <class Bin>
+  static inline Sum MulAddBlock(Sum sum, const Bin* bins,
+                                const int16_t* weights) {
+    int j;
+    for (j = 0; j < kFilterbankSimdWidth; j += 4) {
+      const __m128i m = Energies(bins + j);
+      const __m128i w = _mm_cvtepi16_epi32(
+          _mm_loadl_epi64(reinterpret_cast<const __m128i*>(weights + j)));
+      sum = _mm_add_epi64(sum, _mm_mul_epi32(m, w));
+      sum = _mm_add_epi64(sum, _mm_mul_epi32(_mm_srli_epi64(m, 32),
+                                             _mm_srli_epi64(w, 32)));
+    }
+    return sum;
+  }
+
+  static inline uint64_t Reduce(Sum sum) {
+    uint64_t out[2];
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out), sum);
+    return out[0] + out[1];
+  }
+};
+#elif defined(FILTERBANK_USE_AVX2)
+struct Ops {
+  typedef __m256i Sum;
+
+  static inline Sum Zero() { return _mm256_setzero_si256(); }
+
+  // The energies of a block, as for SSE4.1.
+  static inline __m256i Energies(const int32_t* energy) {
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(energy));
+  }
+  static inline __m256i Energies(const struct complex_int16_t* fft_output) {
+    const __m256i bins =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(fft_output));
+    return _mm256_madd_epi16(bins, bins);
+  }
+
+  // The even and the odd bins separately.
+  template <class Bin>
+  static inline Sum MulAddBlock(Sum sum, const Bin* bins,
+                                const int16_t* weights) {
+    const __m256i m = Energies(bins);
+    const __m256i w = _mm256_cvtepi16_epi32(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(weights)));
+    sum = _mm256_add_epi64(sum, _mm256_mul_epi32(m, w));
+    return _mm256_add_epi64(sum,
+                            _mm256_mul_epi32(_mm256_srli_epi64(m, 32),
+                                             _mm256_srli_epi64(w, 32)));
+  }
+
+  static inline uint64_t Reduce(Sum sum) {
+    const __m128i half = _mm_add_epi64(_mm256_castsi256_si128(sum),
+                                       _mm256_extracti128_si256(sum, 1));
+    uint64_t out[2];
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out), half);
+    return out[0] + out[1];
+  }
+
+  static const int kSqrtLanes = 4;
+
+  // The square roots of up to four work values, as the scalar Sqrt64() and
+  // shifted down. Without unsigned 64-bit compares, the ones between values
+  // that may pass 2^63 flip the sign bits first.
+  static inline void SqrtBlock(const uint64_t* work, int count,
+                               int scale_down_shift, uint32_t* output) {
+    const __m256i lanes = _mm256_cmpgt_epi64(_mm256_set1_epi64x(count),
+                                             _mm256_setr_epi64x(0, 1, 2, 3));
+    const __m256i num =
+        count == kSqrtLanes
+            ? _mm256_loadu_si256(reinterpret_cast<const __m256i*>(work))
+            : _mm256_maskload_epi64(reinterpret_cast<const long long*>(work),
+                                    lanes);
+    // The nearest double: 2^84 + the upper word * 2^32 and 2^52 + the lower
+    // word are both exact, and only their sum rounds.
+    const __m256i kExponent52 = _mm256_set1_epi64x(0x4330000000000000);
+    const __m256i upper = _mm256_or_si256(
+        _mm256_srli_epi64(num, 32), _mm256_set1_epi64x(0x4530000000000000));
+    const __m256i lower = _mm256_blend_epi32(num, kExponent52, 0xAA);
+    const __m256d value = _mm256_add_pd(
+        _mm256_sub_pd(_mm256_castsi256_pd(upper),
+                      _mm256_set1_pd(19342813118337666422669312.0)),
+        _mm256_castsi256_pd(lower));
+    // Adding 2^52 to the whole root leaves it in the low mantissa bits.
+    const __m256d whole_root = _mm256_floor_pd(_mm256_sqrt_pd(value));
+    __m256i root = _mm256_sub_epi64(
+        _mm256_castpd_si256(
+            _mm256_add_pd(whole_root, _mm256_castsi256_pd(kExponent52))),
+        kExponent52);
+    root = _mm256_sub_epi64(root, _mm256_srli_epi64(root, 32));
+
+    const __m256i kSign = _mm256_set1_epi64x(INT64_MIN);
+    const __m256i too_high = _mm256_cmpgt_epi64(
+        _mm256_xor_si256(_mm256_mul_epu32(root, root), kSign),
+        _mm256_xor_si256(num, kSign));
+    root = _mm256_add_epi64(root, too_high);
+    // Below 2^35 from here on.
+    __m256i remainder = _mm256_sub_epi64(num, _mm256_mul_epu32(root, root));
+    const __m256i twice_root = _mm256_add_epi64(root, root);
+    const __m256i carry = _mm256_cmpgt_epi64(remainder, twice_root);
+    // Subtracting the all-ones carry lanes makes them 2 * root + 1.
+    remainder = _mm256_sub_epi64(
+        remainder,
+        _mm256_and_si256(carry, _mm256_sub_epi64(twice_root, carry)));
+    root = _mm256_sub_epi64(root, carry);
+    root = _mm256_sub_epi64(root, _mm256_cmpgt_epi64(remainder, root));
+
+    const __m256i max_root = _mm256_blendv_epi8(
+        _mm256_set1_epi64x(0xFFFFFFFF), _mm256_set1_epi64x(0xFFFF),
+        _mm256_cmpeq_epi64(_mm256_srli_epi64(num, 32),
+                           _mm256_setzero_si256()));
+    root = _mm256_blendv_epi8(root, max_root,
+                              _mm256_cmpgt_epi64(root, max_root));
+    root = _mm256_srl_epi64(root, _mm_cvtsi32_si128(scale_down_shift));
+
+    // The lower words of the four lanes.
+    const __m128i roots = _mm256_castsi256_si128(_mm256_permutevar8x32_epi32(
+        root, _mm256_setr_epi32(0, 2, 4, 6, 0, 2, 4, 6)));
+    if (count == kSqrtLanes) {
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(output), roots);
+    } else {
+      _mm_maskstore_epi32(reinterpret_cast<int*>(output),
+                          _mm_cmpgt_epi32(_mm_set1_epi32(count),
+                                          _mm_setr_epi32(0, 1, 2, 3)),
+                          roots);
+    }
+  }
+};
+#elif defined(FILTERBANK_USE_AVX512)
+struct Ops {
+  typedef __m512i Sum;
+
+  static inline Sum Zero() { return _mm512_setzero_si512(); }
+
+  // The energies of a block as for SSE4.1, one per 64-bit lane and
+  // sign-extended.
+  static inline __m512i Energies(const int32_t* energy) {
+    return _mm512_cvtepi32_epi64(
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(energy)));
+  }
+  static inline __m512i Energies(const struct complex_int16_t* fft_output) {
+    const __m256i bins =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(fft_output));
+    return _mm512_cvtepi32_epi64(_mm256_madd_epi16(bins, bins));
+  }
+
+  template <class Bin>
+  static inline Sum MulAddBlock(Sum sum, const Bin* bins,
+                                const int16_t* weights) {
+    const __m512i w = _mm512_cvtepi16_epi64(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(weights)));
+    return _mm512_add_epi64(sum, _mm512_mul_epi32(Energies(bins), w));
+  }
+
+  static inline uint64_t Reduce(Sum sum) {
+    return static_cast<uint64_t>(_mm512_reduce_add_epi64(sum));
+  }
+
+  static const int kSqrtLanes = 8;
+
+  // The square roots of up to eight work values, as for AVX2 but with the
+  // unsigned conversions and compares of AVX-512.
+  static inline void SqrtBlock(const uint64_t* work, int count,
+                               int scale_down_shift, uint32_t* output) {
+    const __mmask8 lanes = static_cast<__mmask8>((1u << count) - 1);
+    const __m512i num = _mm512_maskz_loadu_epi64(lanes, work);
+    __m512i root =
+        _mm512_cvttpd_epu64(_mm512_sqrt_pd(_mm512_cvtepu64_pd(num)));
+    root = _mm512_sub_epi64(root, _mm512_srli_epi64(root, 32));
+
+    const __m512i kOne = _mm512_set1_epi64(1);
+    root = _mm512_mask_sub_epi64(
+        root, _mm512_cmpgt_epu64_mask(_mm512_mul_epu32(root, root), num), root,
+        kOne);
+    __m512i remainder = _mm512_sub_epi64(num, _mm512_mul_epu32(root, root));
+    const __m512i twice_root = _mm512_add_epi64(root, root);
+    const __mmask8 carry = _mm512_cmpgt_epu64_mask(remainder, twice_root);
+    remainder = _mm512_mask_sub_epi64(remainder, carry, remainder,
+                                      _mm512_add_epi64(twice_root, kOne));
+    root = _mm512_mask_add_epi64(root, carry, root, kOne);
+    root = _mm512_mask_add_epi64(
+        root, _mm512_cmpgt_epu64_mask(remainder, root), root, kOne);
+
+    const __m512i max_root = _mm512_mask_blend_epi64(
+        _mm512_test_epi64_mask(num, _mm512_set1_epi64(0xFFFFFFFF00000000ULL)),
+        _mm512_set1_epi64(0xFFFF), _mm512_set1_epi64(0xFFFFFFFF));
+    root = _mm512_min_epu64(root, max_root);
+    root = _mm512_srl_epi64(root, _mm_cvtsi32_si128(scale_down_shift));
+    _mm256_mask_storeu_epi32(output, lanes, _mm512_cvtepi64_epi32(root));
+  }
+};
+#endif
+
+// Same as the scalar FilterbankAccumulateChannels(), one work value at a
+// time, on either the energies or the FFT output they come from.
+template <class Bin>
+void AccumulateChannels(struct FilterbankState* state, const Bin* bins) {
+  uint64_t* work = state->work;
+  const int16_t* weights = state->simd_weights;
+  const int num_channels_plus_1 = state->num_channels + 1;
+  int i;
+  for (i = 0; i < num_channels_plus_1; ++i) {
+    const Bin* run = bins + state->simd_starts[i];
+    Ops::Sum sum = Ops::Zero();
+    const int num_blocks = state->simd_blocks[i];
+    int block;
+    for (block = 0; block < num_blocks; ++block) {
+      sum = Ops::MulAddBlock(sum, run, weights);
+      run += kFilterbankSimdWidth;
+      weights += kFilterbankSimdWidth;
+    }
+    work[i] = Ops::Reduce(sum);
+  }
+}
+
+#if defined(FILTERBANK_USE_SSE41)
+// SSE4.1 has no 64-bit compares, and keeps the scalar square roots.
+const struct FilterbankKernelSet kKernelSet = {
+    AccumulateChannels<int32_t>, AccumulateChannels<struct complex_int16_t>,
+    nullptr};
+#else
+// Same as the scalar FilterbankSqrt(), kSqrtLanes channels at a time. Each
+// block is loaded before its roots are stored over the work buffer, and the
+// roots never reach the work values of the following blocks.
+void SqrtChannels(struct FilterbankState* state, int scale_down_shift) {
+  const int num_channels = state->num_channels;
+  const uint64_t* work = state->work + 1;
+  uint32_t* output = reinterpret_cast<uint32_t*>(state->work);
+  int i;
+  for (i = 0; i < num_channels; i += Ops::kSqrtLanes) {
+    const int count = num_channels - i < Ops::kSqrtLanes ? num_channels - i
+                                                         : Ops::kSqrtLanes;
+    Ops::SqrtBlock(work + i, count, scale_down_shift, output + i);
+  }
+}
+
+const struct FilterbankKernelSet kKernelSet = {
+    AccumulateChannels<int32_t>, AccumulateChannels<struct complex_int16_t>,
+    SqrtChannels};
+#endif
+
+}  // namespace FILTERBANK_TIER
+}  // namespace filterbank
+
+#endif  // TENSORFLOW_LITE_EXPERIMENTAL_MICROFRONTEND_LIB_FILTERBANK_KERNELS_H_
@@ -16,6 +16,8 @@ limitations under the License.
 
 #include <cstring>
 
+#include "tensorflow/lite/experimental/microfrontend/lib/bits.h"
+#include "tensorflow/lite/experimental/microfrontend/lib/cpu_features.h"
 #include "tensorflow/lite/experimental/microfrontend/lib/filterbank_util.h"
 #include "tensorflow/lite/micro/testing/micro_test.h"
 
@@ -43,6 +45,35 @@ class FilterbankTestConfig {
   struct FilterbankConfig config_;
 };
 
+// The bit-by-bit square root FilterbankSqrt() used to run, with the 32 bit
+// shortcut for numbers that have the upper word clear.
+uint32_t ReferenceSqrt64(uint64_t num) {
+  if (num == 0) {
+    return 0;
+  }
+  const bool shortcut = (num >> 32) == 0;
+  uint64_t res = 0;
+  int max_bit_number = shortcut ? 32 - MostSignificantBit32(num)
+                                : 64 - MostSignificantBit64(num);
+  max_bit_number |= 1;
+  const int top_bit = shortcut ? 31 : 63;
+  uint64_t bit = 1ULL << (top_bit - max_bit_number);
+  int iterations = (top_bit - max_bit_number) / 2 + 1;
+  while (iterations--) {
+    if (num >= res + bit) {
+      num -= res + bit;
+      res = (res >> 1U) + bit;
+    } else {
+      res >>= 1U;
+    }
+    bit >>= 2U;
+  }
+  if (num > res && res != (shortcut ? 0xFFFFu : 0xFFFFFFFFu)) {
+    ++res;
+  }
+  return res;
+}
+
 }  // namespace
 
 TF_LITE_MICRO_TESTS_BEGIN
@@ -182,18 +213,116 @@ TF_LITE_MICRO_TEST(FilterbankTest_CheckAccumulateChannels) {
   TF_LITE_MICRO_EXPECT(FilterbankPopulateState(&config.config_, &state,
                                                kSampleRate, kSpectrumSize));
 
-  FilterbankAccumulateChannels(&state, kEnergy);
-
   TF_LITE_MICRO_EXPECT_EQ(state.num_channels + 1,
                           static_cast<int>(sizeof(kWork) / sizeof(kWork[0])));
+  const int active_tier = CpuActiveTier();
+  int tier;
+  for (tier = 0; tier <= CpuDetectTier(); ++tier) {
+    TF_LITE_MICRO_EXPECT(CpuSetTier(tier));
+    FilterbankAccumulateChannels(&state, kEnergy);
+
+    int i;
+    for (i = 0; i <= state.num_channels; ++i) {
+      TF_LITE_MICRO_EXPECT_EQ(state.work[i], kWork[i]);
+    }
+  }
+  CpuSetTier(active_tier);
+
+  FilterbankFreeStateContents(&state);
+}
+
+TF_LITE_MICRO_TEST(FilterbankTest_CheckSimdLayout) {
+  FilterbankTestConfig config;
+  struct FilterbankState state;
+  TF_LITE_MICRO_EXPECT(FilterbankPopulateState(&config.config_, &state,
+                                               kSampleRate, kSpectrumSize));
+
+  // Each run is the previous channel's unweights, then the channel's own
+  // weights. The last one is moved back to stay inside the spectrum.
+  const int16_t expected_starts[] = {1, 1, 1};
+  const int16_t expected_blocks[] = {1, 1, 2};
+  const int16_t expected_weights[] = {
+      3277, 2217, 1200, 222,  0,    0,    0,    0,    819,  1879, 2896, 3874,
+      3376, 2468, 1591, 744,  0,    0,    0,    0,    720,  1628, 2505, 3352,
+      4020, 3226, 2456, 1708, 983,  277,  0,    0};
   int i;
   for (i = 0; i <= state.num_channels; ++i) {
-    TF_LITE_MICRO_EXPECT_EQ(state.work[i], kWork[i]);
+    TF_LITE_MICRO_EXPECT_EQ(state.simd_starts[i], expected_starts[i]);
+    TF_LITE_MICRO_EXPECT_EQ(state.simd_blocks[i], expected_blocks[i]);
+  }
+  for (size_t j = 0;
+       j < sizeof(expected_weights) / sizeof(expected_weights[0]); ++j) {
+    TF_LITE_MICRO_EXPECT_EQ(state.simd_weights[j], expected_weights[j]);
+  }
+
+  FilterbankFreeStateContents(&state);
+}
+
+TF_LITE_MICRO_TEST(FilterbankTest_CheckPackedLayout) {
+  FilterbankTestConfig config;
+  struct FilterbankState state;
+  TF_LITE_MICRO_EXPECT(FilterbankPopulateState(&config.config_, &state,
+                                               kSampleRate, kSpectrumSize));
+  TF_LITE_MICRO_EXPECT_EQ(reinterpret_cast<uintptr_t>(state.packed) %
+                              kFilterbankPackedAlignment,
+                          static_cast<uintptr_t>(0));
+
+  // Each channel's first bin and width, then its weights and unweights in
+  // pairs, without the padding of the original layout.
+  const int16_t expected[] = {
+      1,    4,    3277, 819,  2217, 1879, 1200, 2896, 222,  3874, 5,
+      4,    3376, 720,  2468, 1628, 1591, 2505, 744,  3352, 9,    6,
+      4020, 76,   3226, 870,  2456, 1640, 1708, 2388, 983,  3113, 277,
+      3819};
+  for (size_t i = 0; i < sizeof(expected) / sizeof(expected[0]); ++i) {
+    TF_LITE_MICRO_EXPECT_EQ(state.packed[i], expected[i]);
   }
 
   FilterbankFreeStateContents(&state);
 }
 
+TF_LITE_MICRO_TEST(FilterbankTest_SimdKernelsMatchScalar) {
+  struct FilterbankConfig config;
+  FilterbankFillConfigWithDefaults(&config);
+  config.num_channels = 40;
+  const int spectrum_size = 257;
+  struct FilterbankState state;
+  TF_LITE_MICRO_EXPECT(
+      FilterbankPopulateState(&config, &state, 16000, spectrum_size));
+  TF_LITE_MICRO_EXPECT(state.simd_weights != nullptr);
+
+  // Full-range energies, including ones that wrapped around to negative
+  // values, which the scalar loop sign-extends.
+  int32_t energy[spectrum_size];
+  uint32_t seed = 5;
+  int i;
+  for (i = 0; i < spectrum_size; ++i) {
+    seed = seed * 1664525u + 1013904223u;
+    energy[i] = static_cast<int32_t>(seed);
+  }
+  energy[state.start_index] = INT32_MIN;
+  energy[state.end_index - 1] = -1;
+
+  const int active_tier = CpuActiveTier();
+  TF_LITE_MICRO_EXPECT(CpuSetTier(kCpuTierScalar));
+  FilterbankAccumulateChannels(&state, energy);
+  uint64_t expected[41];
+  std::memcpy(expected, state.work, sizeof(expected));
+
+  int tier;
+  for (tier = kCpuTierScalar + 1; tier <= CpuDetectTier(); ++tier) {
+    TF_LITE_MICRO_EXPECT(CpuSetTier(tier));
+    std::memset(state.work, 0, sizeof(expected));
+    FilterbankAccumulateChannels(&state, energy);
+    for (i = 0; i <= state.num_channels; ++i) {
+      TF_LITE_MICRO_EXPECT_EQ(state.work[i], expected[i]);
+    }
+  }
+  CpuSetTier(active_tier);
+
+  FilterbankFreeStateContents(&state);
+}
+
 TF_LITE_MICRO_TEST(FilterbankTest_CheckSqrt) {
   FilterbankTestConfig config;
   struct FilterbankState state;
@@ -214,4 +343,108 @@ TF_LITE_MICRO_TEST(FilterbankTest_CheckSqrt) {
   FilterbankFreeStateContents(&state);
 }
 
+TF_LITE_MICRO_TEST(FilterbankTest_AccumulateFftChannelsMatchesTwoPasses) {
+  struct FilterbankConfig config;
+  FilterbankFillConfigWithDefaults(&config);
+  config.num_channels = 40;
+  const int spectrum_size = 257;
+  struct FilterbankState state;
+  TF_LITE_MICRO_EXPECT(
+      FilterbankPopulateState(&config, &state, 16000, spectrum_size));
+
+  // Full-scale bins, and one that overflows the energy to INT32_MIN.
+  struct complex_int16_t fft_output[spectrum_size];
+  uint32_t seed = 9;
+  int i;
+  for (i = 0; i < spectrum_size; ++i) {
+    seed = seed * 1664525u + 1013904223u;
+    fft_output[i].real = static_cast<int16_t>(seed >> 16);
+    fft_output[i].imag = static_cast<int16_t>(seed);
+  }
+  fft_output[state.start_index + 3].real = -32768;
+  fft_output[state.start_index + 3].imag = -32768;
+
+  const int active_tier = CpuActiveTier();
+  int tier;
+  for (tier = 0; tier <= CpuDetectTier(); ++tier) {
+    TF_LITE_MICRO_EXPECT(CpuSetTier(tier));
+    struct complex_int16_t energy_buffer[spectrum_size];
+    std::memcpy(energy_buffer, fft_output, sizeof(fft_output));
+    int32_t* energy = reinterpret_cast<int32_t*>(energy_buffer);
+    FilterbankConvertFftComplexToEnergy(&state, energy_buffer, energy);
+    FilterbankAccumulateChannels(&state, energy);
+    uint64_t expected[41];
+    std::memcpy(expected, state.work, sizeof(expected));
+
+    std::memset(state.work, 0, sizeof(expected));
+    FilterbankAccumulateFftChannels(&state, fft_output);
+    for (i = 0; i <= state.num_channels; ++i) {
+      TF_LITE_MICRO_EXPECT_EQ(state.work[i], expected[i]);
+    }
+  }
+  CpuSetTier(active_tier);
+
+  FilterbankFreeStateContents(&state);
+}
+
+TF_LITE_MICRO_TEST(FilterbankTest_SqrtMatchesBitByBitLoop) {
+  struct FilterbankConfig config;
+  FilterbankFillConfigWithDefaults(&config);
+  // Not a whole number of SIMD blocks.
+  config.num_channels = 37;
+  struct FilterbankState state;
+  TF_LITE_MICRO_EXPECT(FilterbankPopulateState(&config, &state, 16000, 257));
+  const int num_channels = state.num_channels;
+
+  // Squares and the numbers around them, both sides of 2^32 and the ends
+  // of the range, then random numbers of every bit length.
+  const int kNumValues = 300000;
+  uint64_t* values = new uint64_t[kNumValues];
+  int num_values = 0;
+  const uint64_t roots[] = {0,          1,          2,          0xFFFE,
+                            0xFFFF,     0x10000,    0x10001,    0xB504F333,
+                            0xFFFFFFFE, 0xFFFFFFFF, 0x7FFFFFFF, 0x80000000};
+  int i;
+  for (i = 0; i < static_cast<int>(sizeof(roots) / sizeof(roots[0])); ++i) {
+    const uint64_t square = roots[i] * roots[i];
+    values[num_values++] = square - 1;
+    values[num_values++] = square;
+    values[num_values++] = square + 1;
+    values[num_values++] = square + roots[i];
+    values[num_values++] = square + roots[i] + 1;
+  }
+  values[num_values++] = 0xFFFFFFFF;
+  values[num_values++] = 0x100000000ULL;
+  values[num_values++] = 0x8000000000000000ULL;
+  values[num_values++] = ~0ULL;
+  uint64_t seed = 3;
+  while (num_values < kNumValues) {
+    seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+    values[num_values++] = seed >> (seed & 63);
+  }
+
+  const int active_tier = CpuActiveTier();
+  int tier;
+  for (tier = 0; tier <= CpuDetectTier(); ++tier) {
+    TF_LITE_MICRO_EXPECT(CpuSetTier(tier));
+    int start;
+    for (start = 0; start < num_values; start += num_channels) {
+      const int count = num_values - start < num_channels ? num_values - start
+                                                          : num_channels;
+      const int scale_down_shift = (start / num_channels) % 3;
+      std::memset(state.work, 0, (num_channels + 1) * sizeof(*state.work));
+      std::memcpy(state.work + 1, values + start, count * sizeof(*values));
+      const uint32_t* output = FilterbankSqrt(&state, scale_down_shift);
+      for (i = 0; i < count; ++i) {
+        TF_LITE_MICRO_EXPECT_EQ(
+            output[i], ReferenceSqrt64(values[start + i]) >> scale_down_shift);
+      }
+    }
+  }
+  CpuSetTier(active_tier);
+
+  delete[] values;
+  FilterbankFreeStateContents(&state);
+}
+
 TF_LITE_MICRO_TESTS_END
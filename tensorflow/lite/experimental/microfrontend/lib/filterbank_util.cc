@@ -47,6 +47,120 @@ static void CalculateCenterFrequencies(const int num_channels,
   }
 }
 
+// Lays the channels out again for the SIMD kernels, see FilterbankState.
+// Channel i - 1 ends where channel i starts, so the bins of work[i] are one
+// contiguous run: the unweights of channel i - 1 followed by the weights of
+// channel i. A run is moved back where its padding would reach past the
+// spectrum, so that the kernels only read energies inside it.
+static int PopulateSimdLayout(struct FilterbankState* state,
+                              const int16_t* actual_channel_starts,
+                              const int16_t* actual_channel_widths,
+                              int spectrum_size) {
+  const int num_channels_plus_1 = state->num_channels + 1;
+  state->simd_starts =
+      (int16_t*)malloc(num_channels_plus_1 * sizeof(*state->simd_starts));
+  state->simd_blocks =
+      (int16_t*)malloc(num_channels_plus_1 * sizeof(*state->simd_blocks));
+  if (state->simd_starts == NULL || state->simd_blocks == NULL) {
+    fprintf(stderr, "Failed to allocate simd channel buffers\n");
+    return 0;
+  }
+
+  int num_weights = 0;
+  int chan;
+  for (chan = 0; chan < num_channels_plus_1; ++chan) {
+    const int first_bin = actual_channel_starts[chan > 0 ? chan - 1 : 0];
+    const int end_bin =
+        actual_channel_starts[chan] + actual_channel_widths[chan];
+    const int num_blocks =
+        (end_bin - first_bin + kFilterbankSimdWidth - 1) / kFilterbankSimdWidth;
+    const int padded_width = num_blocks * kFilterbankSimdWidth;
+    if (padded_width > spectrum_size) {
+      // Too short to pad, the kernels fall back to the scalar layout.
+      free(state->simd_starts);
+      free(state->simd_blocks);
+      state->simd_starts = NULL;
+      state->simd_blocks = NULL;
+      return 1;
+    }
+    state->simd_starts[chan] = first_bin + padded_width > spectrum_size
+                                   ? spectrum_size - padded_width
+                                   : first_bin;
+    state->simd_blocks[chan] = num_blocks;
+    num_weights += padded_width;
+  }
+
+  state->simd_weights =
+      (int16_t*)calloc(num_weights, sizeof(*state->simd_weights));
+  if (state->simd_weights == NULL) {
+    fprintf(stderr, "Failed to allocate simd weights\n");
+    return 0;
+  }
+
+  // Copy the weights over from the scalar layout, which has them at the same
+  // bins.
+  int16_t* simd_weights = state->simd_weights;
+  for (chan = 0; chan < num_channels_plus_1; ++chan) {
+    int c;
+    for (c = (chan > 0 ? chan - 1 : 0); c <= chan; ++c) {
+      const int bin_offset =
+          actual_channel_starts[c] - state->channel_frequency_starts[c];
+      const int16_t* weights =
+          (c == chan ? state->weights : state->unweights) +
+          state->channel_weight_starts[c] + bin_offset;
+      int16_t* out =
+          simd_weights + actual_channel_starts[c] - state->simd_starts[chan];
+      int j;
+      for (j = 0; j < actual_channel_widths[c]; ++j) {
+        out[j] = weights[j];
+      }
+    }
+    simd_weights += state->simd_blocks[chan] * kFilterbankSimdWidth;
+  }
+  return 1;
+}
+
+// Packs the channels for the scalar kernels, see FilterbankState. Only the
+// bins a channel actually covers are kept, without the alignment padding of
+// the original layout.
+static int PopulatePackedLayout(struct FilterbankState* state,
+                                const int16_t* actual_channel_starts,
+                                const int16_t* actual_channel_widths) {
+  const int num_channels_plus_1 = state->num_channels + 1;
+  int num_values = 0;
+  int chan;
+  for (chan = 0; chan < num_channels_plus_1; ++chan) {
+    num_values += 2 + 2 * actual_channel_widths[chan];
+  }
+
+  state->packed_buffer = malloc(num_values * sizeof(*state->packed) +
+                                kFilterbankPackedAlignment - 1);
+  if (state->packed_buffer == NULL) {
+    fprintf(stderr, "Failed to allocate packed channel buffer\n");
+    return 0;
+  }
+  const uintptr_t address = (uintptr_t)state->packed_buffer;
+  state->packed =
+      (int16_t*)((address + kFilterbankPackedAlignment - 1) &
+                 ~(uintptr_t)(kFilterbankPackedAlignment - 1));
+
+  int16_t* packed = state->packed;
+  for (chan = 0; chan < num_channels_plus_1; ++chan) {
+    const int width = actual_channel_widths[chan];
+    const int offset = state->channel_weight_starts[chan] +
+                       actual_channel_starts[chan] -
+                       state->channel_frequency_starts[chan];
+    *packed++ = actual_channel_starts[chan];
+    *packed++ = width;
+    int j;
+    for (j = 0; j < width; ++j) {
+      *packed++ = state->weights[offset + j];
+      *packed++ = state->unweights[offset + j];
+    }
+  }
+  return 1;
+}
+
 static void QuantizeFilterbankWeights(const float float_weight, int16_t* weight,
                                       int16_t* unweight) {
   *weight = floorf(float_weight * (1 << kFilterbankBits) + 0.5f);
@@ -58,6 +172,11 @@ int FilterbankPopulateState(const struct FilterbankConfig* config,
                             int spectrum_size) {
   state->num_channels = config->num_channels;
   const int num_channels_plus_1 = config->num_channels + 1;
+  state->simd_starts = NULL;
+  state->simd_blocks = NULL;
+  state->simd_weights = NULL;
+  state->packed = NULL;
+  state->packed_buffer = NULL;
 
   // How should we align things to index counts given the byte alignment?
   const int index_alignment =
@@ -200,9 +319,17 @@ int FilterbankPopulateState(const struct FilterbankConfig* config,
     }
   }
 
+  const int layouts_ok =
+      PopulatePackedLayout(state, actual_channel_starts,
+                           actual_channel_widths) &&
+      PopulateSimdLayout(state, actual_channel_starts, actual_channel_widths,
+                         spectrum_size);
   free(center_mel_freqs);
   free(actual_channel_starts);
   free(actual_channel_widths);
+  if (!layouts_ok) {
+    return 0;
+  }
   if (state->end_index >= spectrum_size) {
     fprintf(stderr, "Filterbank end_index is above spectrum size.\n");
     return 0;
@@ -217,4 +344,8 @@ void FilterbankFreeStateContents(struct FilterbankState* state) {
   free(state->weights);
   free(state->unweights);
   free(state->work);
+  free(state->simd_starts);
+  free(state->simd_blocks);
+  free(state->simd_weights);
+  free(state->packed_buffer);
 }
@@ -0,0 +1,302 @@
+/* Copyright 2026 The pymicro-features Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tensorflow/lite/experimental/microfrontend/lib/float_spectrum.h"
+
+#include <math.h>
+#include <string.h>
+
+namespace {
+
+// kissfft's forward radix-4 butterfly on f0[k], f1[k], f2[k] and f3[k], with
+// the second to fourth inputs already multiplied by their twiddles.
+inline void Butterfly4(float* __restrict f0_real, float* __restrict f0_imag,
+                       float* __restrict f1_real, float* __restrict f1_imag,
+                       float* __restrict f2_real, float* __restrict f2_imag,
+                       float* __restrict f3_real, float* __restrict f3_imag,
+                       int k, float s0_real, float s0_imag, float s1_real,
+                       float s1_imag, float s2_real, float s2_imag) {
+  const float s5_real = f0_real[k] - s1_real;
+  const float s5_imag = f0_imag[k] - s1_imag;
+  const float a_real = f0_real[k] + s1_real;
+  const float a_imag = f0_imag[k] + s1_imag;
+  const float s3_real = s0_real + s2_real;
+  const float s3_imag = s0_imag + s2_imag;
+  const float s4_real = s0_real - s2_real;
+  const float s4_imag = s0_imag - s2_imag;
+  f2_real[k] = a_real - s3_real;
+  f2_imag[k] = a_imag - s3_imag;
+  f0_real[k] = a_real + s3_real;
+  f0_imag[k] = a_imag + s3_imag;
+  f1_real[k] = s5_real + s4_imag;
+  f1_imag[k] = s5_imag - s4_real;
+  f3_real[k] = s5_real - s4_imag;
+  f3_imag[k] = s5_imag + s4_real;
+}
+
+// Whether the innermost stage of the complex transform is radix-2 rather than
+// radix-4, as in FftPow2Compute().
+inline bool HasRadix2Stage(const struct FloatSpectrumState* state) {
+  return ((state->log2_size - 1) & 1) != 0;
+}
+
+// The innermost stage of the complex transform, on the permuted input.
+void InnermostStage(struct FloatSpectrumState* state) {
+  const int complex_size = state->fft_size / 2;
+  float* real = state->work_real;
+  float* imag = state->work_imag;
+  int g;
+  if (HasRadix2Stage(state)) {
+    for (g = 0; g < complex_size; g += 2) {
+      const float b_real = real[g + 1];
+      const float b_imag = imag[g + 1];
+      real[g + 1] = real[g] - b_real;
+      imag[g + 1] = imag[g] - b_imag;
+      real[g] += b_real;
+      imag[g] += b_imag;
+    }
+  } else {
+    // The innermost radix-4 stage only has unit twiddles.
+    for (g = 0; g < complex_size; g += 4) {
+      Butterfly4(real + g, imag + g, real + g + 1, imag + g + 1, real + g + 2,
+                 imag + g + 2, real + g + 3, imag + g + 3, 0, real[g + 1],
+                 imag[g + 1], real[g + 2], imag[g + 2], real[g + 3],
+                 imag[g + 3]);
+    }
+  }
+}
+
+// The remaining radix-4 stages of the complex transform, in the same order as
+// FftPow2Compute().
+void OuterStages(struct FloatSpectrumState* state) {
+  const int complex_size = state->fft_size / 2;
+  float* real = state->work_real;
+  float* imag = state->work_imag;
+  const float* twiddles_real = state->twiddles_real;
+  const float* twiddles_imag = state->twiddles_imag;
+
+  int m;
+  int g;
+  if (HasRadix2Stage(state)) {
+    twiddles_real += 1;
+    twiddles_imag += 1;
+    m = 2;
+  } else {
+    twiddles_real += 3;
+    twiddles_imag += 3;
+    m = 4;
+  }
+
+  for (; m < complex_size; m *= 4) {
+    const float* tw1_real = twiddles_real;
+    const float* tw1_imag = twiddles_imag;
+    const float* tw2_real = twiddles_real + m;
+    const float* tw2_imag = twiddles_imag + m;
+    const float* tw3_real = twiddles_real + 2 * m;
+    const float* tw3_imag = twiddles_imag + 2 * m;
+    for (g = 0; g < complex_size; g += 4 * m) {
+      float* __restrict f0_real = real + g;
+      float* __restrict f0_imag = imag + g;
+      float* __restrict f1_real = f0_real + m;
+      float* __restrict f1_imag = f0_imag + m;
+      float* __restrict f2_real = f0_real + 2 * m;
+      float* __restrict f2_imag = f0_imag + 2 * m;
+      float* __restrict f3_real = f0_real + 3 * m;
+      float* __restrict f3_imag = f0_imag + 3 * m;
+      int k;
+      for (k = 0; k < m; ++k) {
+        Butterfly4(
+            f0_real, f0_imag, f1_real, f1_imag, f2_real, f2_imag, f3_real,
+            f3_imag, k,
+            f1_real[k] * tw1_real[k] - f1_imag[k] * tw1_imag[k],
+            f1_real[k] * tw1_imag[k] + f1_imag[k] * tw1_real[k],
+            f2_real[k] * tw2_real[k] - f2_imag[k] * tw2_imag[k],
+            f2_real[k] * tw2_imag[k] + f2_imag[k] * tw2_real[k],
+            f3_real[k] * tw3_real[k] - f3_imag[k] * tw3_imag[k],
+            f3_real[k] * tw3_imag[k] + f3_imag[k] * tw3_real[k]);
+      }
+    }
+    twiddles_real += 3 * m;
+    twiddles_imag += 3 * m;
+  }
+}
+
+// Splits the complex transform into the real transform's bins in
+// [start_index, end_index) and stores their energies. This is kiss_fftr's
+// split without its halving, which the window scaling already accounts for.
+void ComputeEnergy(struct FloatSpectrumState* state) {
+  const int complex_size = state->fft_size / 2;
+  const int mask = complex_size - 1;
+  const float* real = state->work_real;
+  const float* imag = state->work_imag;
+  const float* split_real = state->split_real;
+  const float* split_imag = state->split_imag;
+  float* energy = state->energy;
+  int k;
+  for (k = state->start_index; k < state->end_index; ++k) {
+    const int k1 = k & mask;
+    const int k2 = (complex_size - k) & mask;
+    const float f1_real = real[k1] + real[k2];
+    const float f1_imag = imag[k1] - imag[k2];
+    const float f2_real = real[k1] - real[k2];
+    const float f2_imag = imag[k1] + imag[k2];
+    const float bin_real =
+        f1_real + f2_real * split_real[k] - f2_imag * split_imag[k];
+    const float bin_imag =
+        f1_imag + f2_real * split_imag[k] + f2_imag * split_real[k];
+    energy[k] = bin_real * bin_real + bin_imag * bin_imag;
+  }
+}
+
+}  // namespace
+
+void FloatSpectrumAccumulate(struct FloatSpectrumState* state,
+                             const int16_t* input, size_t input_used) {
+  if (!state->incremental) {
+    return;
+  }
+  const int window_size = state->window_size;
+  const float* window = state->window;
+  float* real = state->work_real;
+  float* imag = state->work_imag;
+  // A pair is ready once both of its samples are in, or once the frame is
+  // complete for a trailing odd sample.
+  int num_pairs = input_used / 2;
+  if (static_cast<int>(input_used) >= window_size) {
+    num_pairs = (window_size + 1) / 2;
+  }
+  if (state->pairs_done == 0 && num_pairs > 0) {
+    // The buffer still holds the previous frame's transform.
+    const int complex_size = state->fft_size / 2;
+    memset(real, 0, complex_size * sizeof(*real));
+    memset(imag, 0, complex_size * sizeof(*imag));
+  }
+  const int leg_mask = HasRadix2Stage(state) ? 1 : 3;
+  int j;
+  for (j = state->pairs_done; j < num_pairs; ++j) {
+    const int n = 2 * j;
+    const float v_real = input[n] * window[n];
+    const float v_imag = (n + 1 < window_size) ? input[n + 1] * window[n + 1]
+                                               : 0.0f;
+    // Add the pair as one leg of its innermost butterfly, whose other legs
+    // may not have arrived yet.
+    const int slot = state->pair_slots[j];
+    const int leg = slot & leg_mask;
+    float* out_real = real + (slot - leg);
+    float* out_imag = imag + (slot - leg);
+    if (leg_mask == 1) {
+      const float sign = leg ? -1.0f : 1.0f;
+      out_real[0] += v_real;
+      out_imag[0] += v_imag;
+      out_real[1] += sign * v_real;
+      out_imag[1] += sign * v_imag;
+      continue;
+    }
+    // Output r gets the leg times (-i)^(leg * r).
+    out_real[0] += v_real;
+    out_imag[0] += v_imag;
+    switch (leg) {
+      case 0:
+        out_real[1] += v_real;
+        out_imag[1] += v_imag;
+        out_real[2] += v_real;
+        out_imag[2] += v_imag;
+        out_real[3] += v_real;
+        out_imag[3] += v_imag;
+        break;
+      case 1:
+        out_real[1] += v_imag;
+        out_imag[1] -= v_real;
+        out_real[2] -= v_real;
+        out_imag[2] -= v_imag;
+        out_real[3] -= v_imag;
+        out_imag[3] += v_real;
+        break;
+      case 2:
+        out_real[1] -= v_real;
+        out_imag[1] -= v_imag;
+        out_real[2] += v_real;
+        out_imag[2] += v_imag;
+        out_real[3] -= v_real;
+        out_imag[3] -= v_imag;
+        break;
+      default:
+        out_real[1] -= v_imag;
+        out_imag[1] += v_real;
+        out_real[2] -= v_real;
+        out_imag[2] -= v_imag;
+        out_real[3] += v_imag;
+        out_imag[3] -= v_real;
+        break;
+    }
+  }
+  state->pairs_done = j;
+}
+
+uint32_t* FloatSpectrumCompute(struct FloatSpectrumState* state,
+                               const int16_t* input) {
+  const int complex_size = state->fft_size / 2;
+  float* real = state->work_real;
+  float* imag = state->work_imag;
+  int i;
+  if (state->incremental) {
+    FloatSpectrumAccumulate(state, input, state->window_size);
+  } else {
+    // Window the input straight into the transform's input order, treating
+    // even samples as real parts and odd ones as imaginary parts.
+    const int window_size = state->window_size;
+    const float* window = state->window;
+    const uint16_t* permutation = state->permutation;
+    for (i = 0; i < complex_size; ++i) {
+      const int n = 2 * permutation[i];
+      real[i] = (n < window_size) ? input[n] * window[n] : 0.0f;
+      imag[i] = (n + 1 < window_size) ? input[n + 1] * window[n + 1] : 0.0f;
+    }
+    InnermostStage(state);
+  }
+  OuterStages(state);
+  ComputeEnergy(state);
+  // The next frame starts accumulating from scratch.
+  state->pairs_done = 0;
+
+  // Same accumulation as FilterbankAccumulateChannels().
+  const float* energy = state->energy;
+  float weight_accumulator = 0.0f;
+  float unweight_accumulator = 0.0f;
+  const int num_channels_plus_1 = state->num_channels + 1;
+  for (i = 0; i < num_channels_plus_1; ++i) {
+    const float* magnitudes = energy + state->channel_frequency_starts[i];
+    const float* weights = state->weights + state->channel_weight_starts[i];
+    const float* unweights = state->unweights + state->channel_weight_starts[i];
+    const int width = state->channel_widths[i];
+    int j;
+    for (j = 0; j < width; ++j) {
+      weight_accumulator += weights[j] * magnitudes[j];
+      unweight_accumulator += unweights[j] * magnitudes[j];
+    }
+    state->channels[i] = weight_accumulator;
+    weight_accumulator = unweight_accumulator;
+    unweight_accumulator = 0.0f;
+  }
+
+  uint32_t* output = state->output;
+  for (i = 0; i < state->num_channels; ++i) {
+    output[i] = static_cast<uint32_t>(sqrtf(state->channels[i + 1]) + 0.5f);
+  }
+  return output;
+}
+
+void FloatSpectrumReset(struct FloatSpectrumState* state) {
+  state->pairs_done = 0;
+}
@@ -0,0 +1,93 @@
+/* Copyright 2026 The pymicro-features Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef TENSORFLOW_LITE_EXPERIMENTAL_MICROFRONTEND_LIB_FLOAT_SPECTRUM_H_
+#define TENSORFLOW_LITE_EXPERIMENTAL_MICROFRONTEND_LIB_FLOAT_SPECTRUM_H_
+
+#include <stdint.h>
+#include <stdlib.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Single-precision replacement for the window, FFT, energy, filterbank and
+// square root stages. It uses the same quantized window and filterbank weights
+// as the fixed-point stages, and produces channel values on the same scale as
+// FilterbankSqrt(), so noise reduction, PCAN and log scaling run unchanged on
+// its output. The values are not bit-exact with the fixed-point path.
+struct FloatSpectrumState {
+  int window_size;
+  int fft_size;
+  int log2_size;
+  int num_channels;
+  int start_index;
+  int end_index;
+  // Window coefficients, with the transform's output scaling folded in.
+  float* window;
+  // Complex transform slot to input pair mapping (owned by the plan cache).
+  const uint16_t* permutation;
+  // The inverse mapping, input pair to slot.
+  uint16_t* pair_slots;
+  // Per-stage twiddles in the FftPow2Plan layout, as separate real and
+  // imaginary arrays.
+  float* twiddles_real;
+  float* twiddles_imag;
+  // Twiddles for the real-input split, one per output bin.
+  float* split_real;
+  float* split_imag;
+  // Complex transform working buffer, fft_size / 2 entries each.
+  float* work_real;
+  float* work_imag;
+  // If set, the innermost stage of the transform is built up in the working
+  // buffer as the frame's samples arrive (see FloatSpectrumAccumulate()), and
+  // pairs_done input pairs have been added to it so far.
+  int incremental;
+  int pairs_done;
+  // Energy per bin. Bins outside [start_index, end_index) stay zero.
+  float* energy;
+  // The FilterbankState channel layout, with float weights.
+  int16_t* channel_frequency_starts;
+  int16_t* channel_weight_starts;
+  int16_t* channel_widths;
+  float* weights;
+  float* unweights;
+  float* channels;
+  uint32_t* output;
+};
+
+// In incremental mode, windows the samples of the next frame that are
+// available in input[0, input_used) and not yet added, and runs the innermost
+// transform stage on them. Every input pair is one leg of an innermost
+// butterfly, so its share of the butterfly outputs can be added as soon as it
+// arrives. This moves that part of the work out of the call that completes
+// the frame. Does nothing outside of incremental mode.
+void FloatSpectrumAccumulate(struct FloatSpectrumState* state,
+                             const int16_t* input, size_t input_used);
+
+// Windows the window_size samples of input, transforms them and returns the
+// num_channels filterbank magnitudes. The returned memory is reused by the next
+// call. In incremental mode, input must hold the same frame the accumulated
+// samples came from.
+uint32_t* FloatSpectrumCompute(struct FloatSpectrumState* state,
+                               const int16_t* input);
+
+// Drops any partially accumulated frame.
+void FloatSpectrumReset(struct FloatSpectrumState* state);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif  // TENSORFLOW_LITE_EXPERIMENTAL_MICROFRONTEND_LIB_FLOAT_SPECTRUM_H_
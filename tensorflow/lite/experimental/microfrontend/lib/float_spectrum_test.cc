@@ -0,0 +1,158 @@
+/* Copyright 2026 The pymicro-features Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tensorflow/lite/experimental/microfrontend/lib/float_spectrum.h"
+
+#include <math.h>
+
+#include "tensorflow/lite/experimental/microfrontend/lib/filterbank_util.h"
+#include "tensorflow/lite/experimental/microfrontend/lib/float_spectrum_util.h"
+#include "tensorflow/lite/experimental/microfrontend/lib/window_util.h"
+#include "tensorflow/lite/micro/testing/micro_test.h"
+
+namespace {
+
+const int kSampleRate = 16000;
+const int kNumTrials = 4;
+
+uint32_t NextRandom(uint32_t* seed) {
+  *seed = *seed * 1664525u + 1013904223u;
+  return *seed >> 16;
+}
+
+// The filterbank magnitudes computed in double precision with a direct DFT.
+void ComputeReference(const struct WindowState* window,
+                      const struct FilterbankState* filterbank, int fft_size,
+                      const int16_t* input, double* output) {
+  const int num_bins = fft_size / 2 + 1;
+  double* energy = new double[num_bins + fft_size]();
+  int k;
+  for (k = filterbank->start_index; k < filterbank->end_index; ++k) {
+    double real = 0.0;
+    double imag = 0.0;
+    size_t n;
+    for (n = 0; n < window->size; ++n) {
+      const double sample = input[n] * (double)window->coefficients[n] /
+                            (1 << kFrontendWindowBits);
+      const double phase = -2.0 * M_PI * k * n / fft_size;
+      real += sample * cos(phase);
+      imag += sample * sin(phase);
+    }
+    energy[k] = (real * real + imag * imag) / ((double)fft_size * fft_size);
+  }
+
+  double weight_accumulator = 0.0;
+  double unweight_accumulator = 0.0;
+  int i;
+  for (i = 0; i <= filterbank->num_channels; ++i) {
+    const int start = filterbank->channel_frequency_starts[i];
+    const int weight_start = filterbank->channel_weight_starts[i];
+    int j;
+    for (j = 0; j < filterbank->channel_widths[i]; ++j) {
+      weight_accumulator +=
+          filterbank->weights[weight_start + j] * energy[start + j];
+      unweight_accumulator +=
+          filterbank->unweights[weight_start + j] * energy[start + j];
+    }
+    if (i > 0) {
+      output[i - 1] = sqrt(weight_accumulator);
+    }
+    weight_accumulator = unweight_accumulator;
+    unweight_accumulator = 0.0;
+  }
+  delete[] energy;
+}
+
+void CheckAgainstReference(size_t size_ms, int num_channels, int incremental) {
+  struct WindowConfig window_config;
+  WindowFillConfigWithDefaults(&window_config);
+  window_config.size_ms = size_ms;
+  struct WindowState window;
+  TF_LITE_MICRO_EXPECT(
+      WindowPopulateState(&window_config, &window, kSampleRate));
+  int fft_size = 1;
+  while (fft_size < static_cast<int>(window.size)) {
+    fft_size <<= 1;
+  }
+
+  struct FilterbankConfig filterbank_config;
+  FilterbankFillConfigWithDefaults(&filterbank_config);
+  filterbank_config.num_channels = num_channels;
+  struct FilterbankState filterbank;
+  TF_LITE_MICRO_EXPECT(FilterbankPopulateState(
+      &filterbank_config, &filterbank, kSampleRate, fft_size / 2 + 1));
+
+  struct FloatSpectrumState state;
+  TF_LITE_MICRO_EXPECT(
+      FloatSpectrumPopulateState(&state, &window, &filterbank, fft_size,
+                                 incremental));
+
+  uint32_t seed = 5;
+  int16_t* input = new int16_t[window.size];
+  double* expected = new double[num_channels];
+  int trial;
+  for (trial = 0; trial < kNumTrials; ++trial) {
+    // Full-scale noise, then quieter signals down to near silence.
+    const int amplitude = 32768 >> (4 * trial);
+    size_t n;
+    for (n = 0; n < window.size; ++n) {
+      input[n] = static_cast<int16_t>(
+          static_cast<int32_t>(NextRandom(&seed) % (2 * amplitude)) -
+          amplitude);
+    }
+    ComputeReference(&window, &filterbank, fft_size, input, expected);
+    // Let the frame arrive in pieces of up to 37 samples.
+    size_t input_used = 0;
+    while (input_used < window.size) {
+      input_used += 1 + NextRandom(&seed) % 37;
+      if (input_used > window.size) {
+        input_used = window.size;
+      }
+      FloatSpectrumAccumulate(&state, input, input_used);
+    }
+    const uint32_t* output = FloatSpectrumCompute(&state, input);
+    int i;
+    for (i = 0; i < num_channels; ++i) {
+      TF_LITE_MICRO_EXPECT_NEAR(static_cast<double>(output[i]), expected[i],
+                                0.5 + 1e-5 * expected[i]);
+    }
+  }
+
+  delete[] input;
+  delete[] expected;
+  FloatSpectrumFreeStateContents(&state);
+  FilterbankFreeStateContents(&filterbank);
+  WindowFreeStateContents(&window);
+}
+
+}  // namespace
+
+TF_LITE_MICRO_TESTS_BEGIN
+
+TF_LITE_MICRO_TEST(FloatSpectrumTest_MatchesReferenceEvenStages) {
+  // 480 samples pad to a 512-point transform, with radix-4 stages only.
+  CheckAgainstReference(30, 40, 0);
+}
+
+TF_LITE_MICRO_TEST(FloatSpectrumTest_MatchesReferenceOddStages) {
+  // 256 samples use a 256-point transform, which needs a radix-2 stage.
+  CheckAgainstReference(16, 32, 0);
+}
+
+TF_LITE_MICRO_TEST(FloatSpectrumTest_IncrementalMatchesReference) {
+  CheckAgainstReference(30, 40, 1);
+  CheckAgainstReference(16, 32, 1);
+}
+
+TF_LITE_MICRO_TESTS_END
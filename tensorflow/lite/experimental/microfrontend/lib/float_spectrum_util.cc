@@ -0,0 +1,182 @@
+/* Copyright 2026 The pymicro-features Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tensorflow/lite/experimental/microfrontend/lib/float_spectrum_util.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "tensorflow/lite/experimental/microfrontend/lib/fft_plan_cache.h"
+
+// Some platforms don't have M_PI
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+namespace {
+
+// Fills the twiddles of every stage of the complex transform, following the
+// layout of FftPow2Plan::twiddles.
+void FillTwiddles(struct FloatSpectrumState* state) {
+  const int complex_size = state->fft_size / 2;
+  float* twiddles_real = state->twiddles_real;
+  float* twiddles_imag = state->twiddles_imag;
+  int m = 1;
+  if ((state->log2_size - 1) & 1) {
+    *twiddles_real++ = 1.0f;
+    *twiddles_imag++ = 0.0f;
+    m = 2;
+  }
+  for (; m < complex_size; m *= 4) {
+    int j;
+    for (j = 1; j <= 3; ++j) {
+      int k;
+      for (k = 0; k < m; ++k) {
+        const double phase = -2.0 * M_PI * j * k / (4.0 * m);
+        *twiddles_real++ = cos(phase);
+        *twiddles_imag++ = sin(phase);
+      }
+    }
+  }
+}
+
+}  // namespace
+
+int FloatSpectrumPopulateState(struct FloatSpectrumState* state,
+                               const struct WindowState* window,
+                               const struct FilterbankState* filterbank,
+                               size_t fft_size, int incremental) {
+  memset(state, 0, sizeof(*state));
+  const struct FftPow2Plan* plan = FftPlanCacheLookup(fft_size);
+  if (plan == NULL) {
+    fprintf(stderr, "No float spectrum transform for size %zu\n", fft_size);
+    return 0;
+  }
+  state->window_size = window->size;
+  state->fft_size = fft_size;
+  state->log2_size = plan->log2_size;
+  state->permutation = plan->permutation;
+  state->incremental = incremental;
+  state->num_channels = filterbank->num_channels;
+  state->start_index = filterbank->start_index;
+  state->end_index = filterbank->end_index;
+
+  const int complex_size = fft_size / 2;
+  const int num_channels_plus_1 = filterbank->num_channels + 1;
+  // The padded channel widths may read past the spectrum, and all weights
+  // share one array.
+  int num_bins = complex_size + 1;
+  int num_weights = 0;
+  int i;
+  for (i = 0; i < num_channels_plus_1; ++i) {
+    const int width = filterbank->channel_widths[i];
+    if (filterbank->channel_frequency_starts[i] + width > num_bins) {
+      num_bins = filterbank->channel_frequency_starts[i] + width;
+    }
+    if (filterbank->channel_weight_starts[i] + width > num_weights) {
+      num_weights = filterbank->channel_weight_starts[i] + width;
+    }
+  }
+
+  state->window = (float*)malloc(state->window_size * sizeof(*state->window));
+  state->twiddles_real =
+      (float*)malloc(complex_size * sizeof(*state->twiddles_real));
+  state->twiddles_imag =
+      (float*)malloc(complex_size * sizeof(*state->twiddles_imag));
+  state->split_real =
+      (float*)malloc((complex_size + 1) * sizeof(*state->split_real));
+  state->split_imag =
+      (float*)malloc((complex_size + 1) * sizeof(*state->split_imag));
+  state->pair_slots =
+      (uint16_t*)malloc(complex_size * sizeof(*state->pair_slots));
+  state->work_real = (float*)malloc(complex_size * sizeof(*state->work_real));
+  state->work_imag = (float*)malloc(complex_size * sizeof(*state->work_imag));
+  state->energy = (float*)calloc(num_bins, sizeof(*state->energy));
+  state->channel_frequency_starts = (int16_t*)malloc(
+      num_channels_plus_1 * sizeof(*state->channel_frequency_starts));
+  state->channel_weight_starts = (int16_t*)malloc(
+      num_channels_plus_1 * sizeof(*state->channel_weight_starts));
+  state->channel_widths =
+      (int16_t*)malloc(num_channels_plus_1 * sizeof(*state->channel_widths));
+  state->weights = (float*)malloc(num_weights * sizeof(*state->weights));
+  state->unweights = (float*)malloc(num_weights * sizeof(*state->unweights));
+  state->channels =
+      (float*)malloc(num_channels_plus_1 * sizeof(*state->channels));
+  state->output =
+      (uint32_t*)malloc(state->num_channels * sizeof(*state->output));
+  if (state->window == NULL || state->twiddles_real == NULL ||
+      state->twiddles_imag == NULL || state->split_real == NULL ||
+      state->split_imag == NULL || state->pair_slots == NULL ||
+      state->work_real == NULL || state->work_imag == NULL ||
+      state->energy == NULL ||
+      state->channel_frequency_starts == NULL ||
+      state->channel_weight_starts == NULL || state->channel_widths == NULL ||
+      state->weights == NULL || state->unweights == NULL ||
+      state->channels == NULL || state->output == NULL) {
+    fprintf(stderr, "Failed to allocate float spectrum buffers\n");
+    return 0;
+  }
+
+  // The fixed-point path computes each bin as the DFT over fft_size of the
+  // windowed input, and its Q12 window coefficients stay in as a fixed-point
+  // scale. Folding both scales into the window, plus the halving the split
+  // skips, leaves no other multiplies in the transform.
+  const double window_scale =
+      1.0 / ((1 << kFrontendWindowBits) * 2.0 * (double)fft_size);
+  for (i = 0; i < state->window_size; ++i) {
+    state->window[i] = window->coefficients[i] * window_scale;
+  }
+
+  for (i = 0; i < complex_size; ++i) {
+    state->pair_slots[state->permutation[i]] = i;
+  }
+  FillTwiddles(state);
+  for (i = 0; i <= complex_size; ++i) {
+    const double phase = -M_PI * ((double)i / complex_size + 0.5);
+    state->split_real[i] = cos(phase);
+    state->split_imag[i] = sin(phase);
+  }
+
+  memcpy(state->channel_frequency_starts, filterbank->channel_frequency_starts,
+         num_channels_plus_1 * sizeof(*state->channel_frequency_starts));
+  memcpy(state->channel_weight_starts, filterbank->channel_weight_starts,
+         num_channels_plus_1 * sizeof(*state->channel_weight_starts));
+  memcpy(state->channel_widths, filterbank->channel_widths,
+         num_channels_plus_1 * sizeof(*state->channel_widths));
+  for (i = 0; i < num_weights; ++i) {
+    state->weights[i] = filterbank->weights[i];
+    state->unweights[i] = filterbank->unweights[i];
+  }
+  return 1;
+}
+
+void FloatSpectrumFreeStateContents(struct FloatSpectrumState* state) {
+  free(state->window);
+  free(state->twiddles_real);
+  free(state->twiddles_imag);
+  free(state->split_real);
+  free(state->split_imag);
+  free(state->pair_slots);
+  free(state->work_real);
+  free(state->work_imag);
+  free(state->energy);
+  free(state->channel_frequency_starts);
+  free(state->channel_weight_starts);
+  free(state->channel_widths);
+  free(state->weights);
+  free(state->unweights);
+  free(state->channels);
+  free(state->output);
+}
@@ -0,0 +1,41 @@
+/* Copyright 2026 The pymicro-features Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef TENSORFLOW_LITE_EXPERIMENTAL_MICROFRONTEND_LIB_FLOAT_SPECTRUM_UTIL_H_
+#define TENSORFLOW_LITE_EXPERIMENTAL_MICROFRONTEND_LIB_FLOAT_SPECTRUM_UTIL_H_
+
+#include "tensorflow/lite/experimental/microfrontend/lib/filterbank.h"
+#include "tensorflow/lite/experimental/microfrontend/lib/float_spectrum.h"
+#include "tensorflow/lite/experimental/microfrontend/lib/window.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Allocates any buffers, taking the window coefficients and the filterbank
+// layout and weights from the already populated fixed-point states. A non-zero
+// incremental selects the incremental mode of FloatSpectrumAccumulate().
+int FloatSpectrumPopulateState(struct FloatSpectrumState* state,
+                               const struct WindowState* window,
+                               const struct FilterbankState* filterbank,
+                               size_t fft_size, int incremental);
+
+// Frees any allocated buffers.
+void FloatSpectrumFreeStateContents(struct FloatSpectrumState* state);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif  // TENSORFLOW_LITE_EXPERIMENTAL_MICROFRONTEND_LIB_FLOAT_SPECTRUM_UTIL_H_
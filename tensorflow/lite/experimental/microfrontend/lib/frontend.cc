@@ -16,57 +16,188 @@ limitations under the License.
 
 #include "tensorflow/lite/experimental/microfrontend/lib/bits.h"
 
-struct FrontendOutput FrontendProcessSamples(struct FrontendState* state,
-                                             const int16_t* samples,
-                                             size_t num_samples,
-                                             size_t* num_samples_read) {
+// Runs the noise reduction and gain control of one chain.
+static void ApplyGainStages(struct NoiseReductionState* noise_reduction,
+                            struct PcanGainControlState* pcan_gain_control,
+                            uint32_t* scaled_filterbank) {
+  // Apply noise reduction.
+  NoiseReductionApply(noise_reduction, scaled_filterbank);
+
+  if (pcan_gain_control->enable_pcan) {
+    PcanGainControlApply(pcan_gain_control, scaled_filterbank);
+  }
+}
+
+// Runs the stages after the filterbank square root of one chain.
+static struct FrontendOutput ApplyBackHalf(
+    struct NoiseReductionState* noise_reduction,
+    struct PcanGainControlState* pcan_gain_control,
+    struct LogScaleState* log_scale, uint32_t* scaled_filterbank,
+    int num_channels, int correction_bits) {
+  ApplyGainStages(noise_reduction, pcan_gain_control, scaled_filterbank);
+
+  // Apply the log and scale.
   struct FrontendOutput output;
-  output.values = NULL;
-  output.size = 0;
+  output.values = LogScaleApply(log_scale, scaled_filterbank, num_channels,
+                                correction_bits);
+  output.size = num_channels;
+  return output;
+}
+
+// Runs the stages up to the filterbank square root, and returns its output,
+// or NULL if the frame is not complete yet.
+static uint32_t* ApplyFrontHalf(struct FrontendState* state,
+                                const int16_t* samples, size_t num_samples,
+                                size_t* num_samples_read, int* input_shift) {
+  // The shift of the fixed-point transform's input, which the heads undo as
+  // well.
+  *input_shift = 0;
+  if (state->float_spectrum != NULL) {
+    // Same framing, but the float engine applies the window itself.
+    const int frame_ready = WindowBufferSamples(&state->window, samples,
+                                                num_samples, num_samples_read);
+    // Start on the transform with whatever part of the frame is in.
+    FloatSpectrumAccumulate(state->float_spectrum, state->window.input,
+                            state->window.input_used);
+    if (!frame_ready) {
+      return NULL;
+    }
+    uint32_t* scaled_filterbank =
+        FloatSpectrumCompute(state->float_spectrum, state->window.input);
+    WindowAdvance(&state->window);
+    return scaled_filterbank;
+  }
 
   // Try to apply the window - if it fails, return and wait for more data.
   if (!WindowProcessSamples(&state->window, samples, num_samples,
                             num_samples_read)) {
-    return output;
+    return NULL;
   }
 
-  // Apply the FFT to the window's output (and scale it so that the fixed point
-  // FFT can have as much resolution as possible).
-  int input_shift =
-      15 - MostSignificantBit32(state->window.max_abs_output_value);
-  FftCompute(&state->fft, state->window.output, input_shift);
+  // Apply the FFT to the window's output (and scale it so that the fixed
+  // point FFT can have as much resolution as possible).
+  *input_shift = 15 - MostSignificantBit32(state->window.max_abs_output_value);
+  FftCompute(&state->fft, state->window.output, *input_shift);
 
-  // We can re-ruse the fft's output buffer to hold the energy.
-  int32_t* energy = (int32_t*)state->fft.output;
+  // The energies are computed as the channels are accumulated.
+  FilterbankAccumulateFftChannels(&state->filterbank, state->fft.output);
+  return FilterbankSqrt(&state->filterbank, *input_shift);
+}
 
-  FilterbankConvertFftComplexToEnergy(&state->filterbank, state->fft.output,
-                                      energy);
+static int CorrectionBits(const struct FrontendState* state) {
+  return MostSignificantBit32(state->fft.fft_size) - 1 - (kFilterbankBits / 2);
+}
 
-  FilterbankAccumulateChannels(&state->filterbank, energy);
-  uint32_t* scaled_filterbank = FilterbankSqrt(&state->filterbank, input_shift);
+// Runs the extra heads on the spectrum of the last frame. If the frame is
+// not emitted, they only run as far as the noise reduction and their
+// outputs are cleared, like the frontend's own.
+static void ApplyHeads(struct FrontendState* state, int input_shift,
+                       int correction_bits, int emit) {
+  int i;
+  for (i = 0; i < state->num_heads; ++i) {
+    struct FrontendHeadState* head = &state->heads[i];
+    FilterbankAccumulateFftChannels(&head->filterbank, state->fft.output);
+    uint32_t* scaled_filterbank =
+        FilterbankSqrt(&head->filterbank, input_shift);
+    if (!emit) {
+      NoiseReductionApply(&head->noise_reduction, scaled_filterbank);
+      head->output.values = NULL;
+      head->output.size = 0;
+      continue;
+    }
+    head->output = ApplyBackHalf(
+        &head->noise_reduction, &head->pcan_gain_control, &head->log_scale,
+        scaled_filterbank, head->filterbank.num_channels, correction_bits);
+  }
+}
 
-  // Apply noise reduction.
+// Runs the rest of a frame the emission stride skips. Only the noise
+// estimates carry over to the next frame, so the gain control and log are
+// left out.
+static void SkipFrame(struct FrontendState* state, uint32_t* scaled_filterbank,
+                      int input_shift) {
   NoiseReductionApply(&state->noise_reduction, scaled_filterbank);
+  ApplyHeads(state, input_shift, CorrectionBits(state), 0);
+}
 
-  if (state->pcan_gain_control.enable_pcan) {
-    PcanGainControlApply(&state->pcan_gain_control, scaled_filterbank);
+int FrontendAdvanceEmission(struct FrontendState* state) {
+  if (state->emit_stride <= 1) {
+    return 1;
   }
+  const int emit = state->frame_in_stride == state->emit_phase;
+  if (++state->frame_in_stride == state->emit_stride) {
+    state->frame_in_stride = 0;
+  }
+  return emit;
+}
 
-  // Apply the log and scale.
-  int correction_bits =
-      MostSignificantBit32(state->fft.fft_size) - 1 - (kFilterbankBits / 2);
-  uint16_t* logged_filterbank =
-      LogScaleApply(&state->log_scale, scaled_filterbank,
-                    state->filterbank.num_channels, correction_bits);
-
-  output.size = state->filterbank.num_channels;
-  output.values = logged_filterbank;
+struct FrontendOutput FrontendProcessSamples(struct FrontendState* state,
+                                             const int16_t* samples,
+                                             size_t num_samples,
+                                             size_t* num_samples_read) {
+  struct FrontendOutput output;
+  output.values = NULL;
+  output.size = 0;
+
+  int input_shift;
+  uint32_t* scaled_filterbank = ApplyFrontHalf(
+      state, samples, num_samples, num_samples_read, &input_shift);
+  if (scaled_filterbank == NULL) {
+    return output;
+  }
+  if (!FrontendAdvanceEmission(state)) {
+    SkipFrame(state, scaled_filterbank, input_shift);
+    return output;
+  }
+
+  const int correction_bits = CorrectionBits(state);
+  output = ApplyBackHalf(&state->noise_reduction, &state->pcan_gain_control,
+                         &state->log_scale, scaled_filterbank,
+                         state->filterbank.num_channels, correction_bits);
+  ApplyHeads(state, input_shift, correction_bits, 1);
   return output;
 }
 
+size_t FrontendProcessSamplesToFloat(struct FrontendState* state,
+                                     const int16_t* samples,
+                                     size_t num_samples,
+                                     size_t* num_samples_read, float scale,
+                                     float* features) {
+  int input_shift;
+  uint32_t* scaled_filterbank = ApplyFrontHalf(
+      state, samples, num_samples, num_samples_read, &input_shift);
+  if (scaled_filterbank == NULL) {
+    return 0;
+  }
+  if (!FrontendAdvanceEmission(state)) {
+    SkipFrame(state, scaled_filterbank, input_shift);
+    return 0;
+  }
+
+  const int correction_bits = CorrectionBits(state);
+  ApplyGainStages(&state->noise_reduction, &state->pcan_gain_control,
+                  scaled_filterbank);
+  LogScaleApplyToFloat(&state->log_scale, scaled_filterbank,
+                       state->filterbank.num_channels, correction_bits, scale,
+                       features);
+  ApplyHeads(state, input_shift, correction_bits, 1);
+  return state->filterbank.num_channels;
+}
+
 void FrontendReset(struct FrontendState* state) {
   WindowReset(&state->window);
   FftReset(&state->fft);
   FilterbankReset(&state->filterbank);
   NoiseReductionReset(&state->noise_reduction);
+  state->frame_in_stride = 0;
+  if (state->float_spectrum != NULL) {
+    FloatSpectrumReset(state->float_spectrum);
+  }
+  int i;
+  for (i = 0; i < state->num_heads; ++i) {
+    FilterbankReset(&state->heads[i].filterbank);
+    NoiseReductionReset(&state->heads[i].noise_reduction);
+    state->heads[i].output.values = NULL;
+    state->heads[i].output.size = 0;
+  }
 }
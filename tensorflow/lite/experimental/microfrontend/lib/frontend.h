@@ -20,6 +20,7 @@ limitations under the License.
 
 #include "tensorflow/lite/experimental/microfrontend/lib/fft.h"
 #include "tensorflow/lite/experimental/microfrontend/lib/filterbank.h"
+#include "tensorflow/lite/experimental/microfrontend/lib/float_spectrum.h"
 #include "tensorflow/lite/experimental/microfrontend/lib/log_scale.h"
 #include "tensorflow/lite/experimental/microfrontend/lib/noise_reduction.h"
 #include "tensorflow/lite/experimental/microfrontend/lib/pcan_gain_control.h"
@@ -29,6 +30,23 @@ limitations under the License.
 extern "C" {
 #endif
 
+struct FrontendOutput {
+  const uint16_t* values;
+  size_t size;
+};
+
+// An extra filterbank, noise reduction, gain control and log chain, fed by
+// the same window and FFT as the frontend's own.
+struct FrontendHeadState {
+  struct FilterbankState filterbank;
+  struct NoiseReductionState noise_reduction;
+  struct PcanGainControlState pcan_gain_control;
+  struct LogScaleState log_scale;
+  // The output of the last frame, valid until the next one is produced.
+  // Empty if the emission stride skipped that frame.
+  struct FrontendOutput output;
+};
+
 struct FrontendState {
   struct WindowState window;
   struct FftState fft;
@@ -36,11 +54,17 @@ struct FrontendState {
   struct NoiseReductionState noise_reduction;
   struct PcanGainControlState pcan_gain_control;
   struct LogScaleState log_scale;
-};
-
-struct FrontendOutput {
-  const uint16_t* values;
-  size_t size;
+  // When set, replaces the window through filterbank square root stages.
+  struct FloatSpectrumState* float_spectrum;
+  // Extra chains on the same spectrum, each with its own output.
+  int num_heads;
+  struct FrontendHeadState* heads;
+  // Which frames have their features emitted (see FrontendConfig), where
+  // frame_in_stride is the position of the next frame within the stride. A
+  // stride of 0, as in a zeroed state, emits every frame like 1.
+  int emit_stride;
+  int emit_phase;
+  int frame_in_stride;
 };
 
 // Main entry point to processing frontend samples. Updates num_samples_read to
@@ -49,12 +73,30 @@ struct FrontendOutput {
 // added to generate a feature vector, the returned size will be 0 and the
 // values pointer will be NULL. Note that the output pointer will be invalidated
 // as soon as FrontendProcessSamples is called again, so copy the contents
-// elsewhere if you need to use them later.
+// elsewhere if you need to use them later. Each frame also runs the extra
+// heads, and leaves their outputs in heads[i].output. Frames skipped by the
+// emission stride only update the noise estimates, and return no output
+// either.
 struct FrontendOutput FrontendProcessSamples(struct FrontendState* state,
                                              const int16_t* samples,
                                              size_t num_samples,
                                              size_t* num_samples_read);
 
+// Same as FrontendProcessSamples(), but the features of a frame are
+// converted to float and multiplied by scale in the same pass as their log,
+// into features, which has room for filterbank.num_channels values. Returns
+// the number of features, or 0 if not enough samples were added to generate
+// them. The heads' outputs stay 16-bit.
+size_t FrontendProcessSamplesToFloat(struct FrontendState* state,
+                                     const int16_t* samples,
+                                     size_t num_samples,
+                                     size_t* num_samples_read, float scale,
+                                     float* features);
+
+// Moves the emission stride on by a frame, and returns whether that frame's
+// features are emitted.
+int FrontendAdvanceEmission(struct FrontendState* state);
+
 void FrontendReset(struct FrontendState* state);
 
 #ifdef __cplusplus
@@ -24,6 +24,14 @@ limitations under the License.
 
 int WriteFrontendStateMemmap(const char* header, const char* source,
                              const struct FrontendState* state) {
+  if (state->num_heads > 0) {
+    fprintf(stderr, "Extra frontend heads are not supported in memmaps\n");
+    return 0;
+  }
+  if (state->float_spectrum != NULL) {
+    fprintf(stderr, "The float engine is not supported in memmaps\n");
+    return 0;
+  }
   // Write a header that just has our init function.
   FILE* fp = fopen(header, "w");
   if (!fp) {
@@ -60,6 +68,10 @@ int WriteFrontendStateMemmap(const char* header, const char* source,
   NoiseReductionWriteMemmap(fp, &state->noise_reduction,
                             "  (&state.noise_reduction)");
   LogScaleWriteMemmap(fp, &state->log_scale, "  (&state.log_scale)");
+  if (state->emit_stride > 1) {
+    fprintf(fp, "  state.emit_stride = %d;\n", state->emit_stride);
+    fprintf(fp, "  state.emit_phase = %d;\n", state->emit_phase);
+  }
   fprintf(fp, "  FftInit(&state.fft);\n");
   fprintf(fp, "  FrontendReset(&state);\n");
   fprintf(fp, "  return &state;\n");
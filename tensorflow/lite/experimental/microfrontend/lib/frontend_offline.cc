@@ -0,0 +1,375 @@
+/* Copyright 2026 The pymicro-features Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tensorflow/lite/experimental/microfrontend/lib/frontend_offline.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include <atomic>
+#include <new>
+#include <thread>
+
+#include "tensorflow/lite/experimental/microfrontend/lib/bits.h"
+#include "tensorflow/lite/experimental/microfrontend/lib/fft_backend.h"
+#include "tensorflow/lite/experimental/microfrontend/lib/fft_util.h"
+
+namespace {
+
+// Frames a thread takes on at once.
+const size_t kChunkFrames = 32;
+// Chunks per thread whose square roots can wait for the back half at the
+// same time, which bounds the memory a long recording needs.
+const int kSlotsPerThread = 4;
+
+// What one thread needs for the front half of a frame. The filterbank is a
+// copy of the frontend's that shares its weights but has its own work
+// values.
+struct Worker {
+  int16_t* windowed;
+  struct FftState fft;
+  struct FilterbankState filterbank;
+};
+
+int PopulateWorker(const struct FrontendState* state, Worker* worker) {
+  memset(worker, 0, sizeof(*worker));
+  worker->windowed = reinterpret_cast<int16_t*>(
+      malloc(state->window.size * sizeof(*worker->windowed)));
+  if (worker->windowed == nullptr) {
+    fprintf(stderr, "Failed to alloc offline window buffer\n");
+    return 0;
+  }
+  if (!FftPopulateStateWithBackend(&worker->fft, state->window.size,
+                                   state->fft.backend->name)) {
+    fprintf(stderr, "Failed to populate offline fft state\n");
+    return 0;
+  }
+  FftInit(&worker->fft);
+  worker->fft.output_start_index = state->fft.output_start_index;
+  worker->fft.output_end_index = state->fft.output_end_index;
+  worker->filterbank = state->filterbank;
+  worker->filterbank.packed_buffer = nullptr;
+  worker->filterbank.work = reinterpret_cast<uint64_t*>(
+      malloc((state->filterbank.num_channels + 1) *
+             sizeof(*worker->filterbank.work)));
+  if (worker->filterbank.work == nullptr) {
+    fprintf(stderr, "Failed to alloc offline filterbank work buffer\n");
+    return 0;
+  }
+  return 1;
+}
+
+void FreeWorker(Worker* worker) {
+  free(worker->windowed);
+  FftFreeStateContents(&worker->fft);
+  free(worker->filterbank.work);
+}
+
+// Where the features of a frame go once the log scale is applied.
+struct Output16 {
+  uint16_t* features;
+
+  void Store(struct FrontendState* state, size_t frame, uint32_t* signal,
+             int correction_bits) const {
+    const int num_channels = state->filterbank.num_channels;
+    memcpy(features + frame * num_channels,
+           LogScaleApply(&state->log_scale, signal, num_channels,
+                         correction_bits),
+           num_channels * sizeof(*features));
+  }
+};
+struct OutputFloat {
+  float* features;
+  float scale;
+
+  void Store(struct FrontendState* state, size_t frame, uint32_t* signal,
+             int correction_bits) const {
+    const int num_channels = state->filterbank.num_channels;
+    LogScaleApplyToFloat(&state->log_scale, signal, num_channels,
+                         correction_bits, scale,
+                         features + frame * num_channels);
+  }
+};
+
+// The work shared between the threads. Chunk c waits in slot c % num_slots
+// of roots, and ready[c % num_slots] is set to c + 1 once it is in.
+struct Recording {
+  const struct FrontendState* state;
+  const int16_t* samples;
+  size_t num_frames;
+  size_t num_chunks;
+  size_t num_slots;
+  uint32_t* roots;
+  std::atomic<size_t>* ready;
+  // The next chunk to take on, and the first one the back half has not
+  // finished, whose slot and the ones after it are still taken.
+  std::atomic<size_t> next_chunk;
+  std::atomic<size_t> back_chunk;
+};
+
+// The number of frames in num_samples samples, emitted or not.
+size_t CountFrames(const struct FrontendState* state, size_t num_samples) {
+  if (num_samples < state->window.size) {
+    return 0;
+  }
+  return (num_samples - state->window.size) / state->window.step + 1;
+}
+
+uint32_t* SlotRoots(const Recording* recording, size_t chunk) {
+  return recording->roots + (chunk % recording->num_slots) * kChunkFrames *
+                                recording->state->filterbank.num_channels;
+}
+
+// Runs the window, FFT, filterbank and square root on one frame.
+void ComputeRoots(const Recording* recording, size_t frame, Worker* worker,
+                  uint32_t* roots) {
+  const struct FrontendState* state = recording->state;
+  const int16_t max_abs_output_value =
+      WindowApply(&state->window,
+                  recording->samples + frame * state->window.step,
+                  worker->windowed);
+  const int input_shift = 15 - MostSignificantBit32(max_abs_output_value);
+  FftCompute(&worker->fft, worker->windowed, input_shift);
+  FilterbankAccumulateFftChannels(&worker->filterbank, worker->fft.output);
+  memcpy(roots, FilterbankSqrt(&worker->filterbank, input_shift),
+         state->filterbank.num_channels * sizeof(*roots));
+}
+
+enum TakeResult { kTaken, kSlotsFull, kNoChunksLeft };
+
+// Takes on the next chunk if its slot is free.
+TakeResult TakeChunk(Recording* recording, Worker* worker) {
+  size_t chunk = recording->next_chunk.load(std::memory_order_relaxed);
+  do {
+    if (chunk >= recording->num_chunks) {
+      return kNoChunksLeft;
+    }
+    if (chunk >= recording->back_chunk.load(std::memory_order_acquire) +
+                     recording->num_slots) {
+      return kSlotsFull;
+    }
+  } while (!recording->next_chunk.compare_exchange_weak(
+      chunk, chunk + 1, std::memory_order_relaxed));
+
+  const int num_channels = recording->state->filterbank.num_channels;
+  uint32_t* roots = SlotRoots(recording, chunk);
+  const size_t first = chunk * kChunkFrames;
+  size_t frame;
+  for (frame = first;
+       frame < first + kChunkFrames && frame < recording->num_frames;
+       ++frame) {
+    ComputeRoots(recording, frame, worker, roots);
+    roots += num_channels;
+  }
+  recording->ready[chunk % recording->num_slots].store(
+      chunk + 1, std::memory_order_release);
+  return kTaken;
+}
+
+void RunWorker(Recording* recording, Worker* worker) {
+  TakeResult result;
+  while ((result = TakeChunk(recording, worker)) != kNoChunksLeft) {
+    if (result == kSlotsFull) {
+      std::this_thread::yield();
+    }
+  }
+}
+
+// The back half of the calling thread: the noise reduction, gain control
+// and log scale of each chunk in order, taking chunks of its own while the
+// next one is not ready. Frames the emission stride skips only run the
+// noise reduction. Returns the number of frames emitted.
+template <class Output>
+size_t RunBackHalf(struct FrontendState* state, Recording* recording,
+                   Worker* worker, const Output& output) {
+  const int num_channels = state->filterbank.num_channels;
+  const int correction_bits =
+      MostSignificantBit32(state->fft.fft_size) - 1 - (kFilterbankBits / 2);
+  size_t num_emitted = 0;
+  size_t chunk;
+  for (chunk = 0; chunk < recording->num_chunks;) {
+    if (recording->ready[chunk % recording->num_slots].load(
+            std::memory_order_acquire) != chunk + 1) {
+      if (TakeChunk(recording, worker) != kTaken) {
+        std::this_thread::yield();
+      }
+      continue;
+    }
+    uint32_t* signal = SlotRoots(recording, chunk);
+    const size_t first = chunk * kChunkFrames;
+    size_t frame;
+    for (frame = first;
+         frame < first + kChunkFrames && frame < recording->num_frames;
+         ++frame) {
+      NoiseReductionApply(&state->noise_reduction, signal);
+      if (FrontendAdvanceEmission(state)) {
+        if (state->pcan_gain_control.enable_pcan) {
+          PcanGainControlApply(&state->pcan_gain_control, signal);
+        }
+        output.Store(state, num_emitted++, signal, correction_bits);
+      }
+      signal += num_channels;
+    }
+    ++chunk;
+    recording->back_chunk.store(chunk, std::memory_order_release);
+  }
+  return num_emitted;
+}
+
+template <class Output>
+int ProcessRecording(struct FrontendState* state, const int16_t* samples,
+                     size_t num_samples, int num_threads,
+                     const Output& output, size_t* num_frames) {
+  *num_frames = 0;
+  if (state->float_spectrum != nullptr || state->num_heads > 0) {
+    fprintf(stderr,
+            "Offline extraction does not support the float engine or extra "
+            "heads\n");
+    return 0;
+  }
+  if (state->window.input_used != 0) {
+    fprintf(stderr, "Offline extraction needs a state with no samples\n");
+    return 0;
+  }
+
+  Recording recording;
+  recording.state = state;
+  recording.samples = samples;
+  recording.num_frames = CountFrames(state, num_samples);
+  recording.num_chunks =
+      (recording.num_frames + kChunkFrames - 1) / kChunkFrames;
+  if (num_threads <= 0) {
+    num_threads = std::thread::hardware_concurrency();
+  }
+  if (static_cast<size_t>(num_threads) > recording.num_chunks) {
+    num_threads = recording.num_chunks;
+  }
+  if (num_threads < 1) {
+    num_threads = 1;
+  }
+  recording.num_slots = kSlotsPerThread * num_threads;
+  // Nothing may throw out of the C API, so the buffers are malloced and
+  // the atomics and threads constructed in them.
+  recording.roots = reinterpret_cast<uint32_t*>(
+      malloc(recording.num_slots * kChunkFrames *
+             state->filterbank.num_channels * sizeof(*recording.roots)));
+  recording.ready = reinterpret_cast<std::atomic<size_t>*>(
+      malloc(recording.num_slots * sizeof(*recording.ready)));
+  Worker* workers =
+      reinterpret_cast<Worker*>(malloc(num_threads * sizeof(*workers)));
+  std::thread* threads = reinterpret_cast<std::thread*>(
+      malloc(num_threads * sizeof(*threads)));
+  int num_workers = 0;
+  int ok = recording.roots != nullptr && recording.ready != nullptr &&
+           workers != nullptr && threads != nullptr;
+  if (!ok) {
+    fprintf(stderr, "Failed to alloc offline extraction buffers\n");
+  } else {
+    size_t i;
+    for (i = 0; i < recording.num_slots; ++i) {
+      new (&recording.ready[i]) std::atomic<size_t>(0);
+    }
+  }
+  recording.next_chunk.store(0, std::memory_order_relaxed);
+  recording.back_chunk.store(0, std::memory_order_relaxed);
+
+  // The calling thread is workers[0]. The others only run if they could be
+  // set up.
+  if (ok) {
+    ok = PopulateWorker(state, &workers[0]);
+    num_workers = 1;
+  }
+  for (; ok && num_workers < num_threads; ++num_workers) {
+    if (!PopulateWorker(state, &workers[num_workers])) {
+      FreeWorker(&workers[num_workers]);
+      break;
+    }
+    // Thread creation throws std::system_error, or std::bad_alloc for its
+    // shared state.
+    try {
+      new (&threads[num_workers])
+          std::thread(RunWorker, &recording, &workers[num_workers]);
+    } catch (...) {
+      FreeWorker(&workers[num_workers]);
+      break;
+    }
+  }
+  size_t num_emitted = 0;
+  if (ok) {
+    num_emitted = RunBackHalf(state, &recording, &workers[0], output);
+  }
+  int t;
+  for (t = 1; t < num_workers; ++t) {
+    threads[t].join();
+    threads[t].~thread();
+  }
+  for (t = 0; t < num_workers; ++t) {
+    FreeWorker(&workers[t]);
+  }
+  free(threads);
+  free(workers);
+  free(recording.ready);
+  free(recording.roots);
+  if (!ok) {
+    return 0;
+  }
+
+  // Leave the samples after the last frame buffered, as streaming does.
+  const size_t consumed = recording.num_frames * state->window.step;
+  memcpy(state->window.input, samples + consumed,
+         (num_samples - consumed) * sizeof(*samples));
+  state->window.input_used = num_samples - consumed;
+  *num_frames = num_emitted;
+  return 1;
+}
+
+}  // namespace
+
+size_t FrontendNumFrames(const struct FrontendState* state,
+                         size_t num_samples) {
+  const size_t num_frames = CountFrames(state, num_samples);
+  if (state->emit_stride <= 1) {
+    return num_frames;
+  }
+  // The first emitted frame, and every emit_stride-th one after it.
+  const size_t first = (state->emit_phase - state->frame_in_stride +
+                        state->emit_stride) %
+                       state->emit_stride;
+  if (num_frames <= first) {
+    return 0;
+  }
+  return (num_frames - first - 1) / state->emit_stride + 1;
+}
+
+int FrontendProcessRecording(struct FrontendState* state,
+                             const int16_t* samples, size_t num_samples,
+                             int num_threads, uint16_t* features,
+                             size_t* num_frames) {
+  Output16 output;
+  output.features = features;
+  return ProcessRecording(state, samples, num_samples, num_threads, output,
+                          num_frames);
+}
+
+int FrontendProcessRecordingToFloat(struct FrontendState* state,
+                                    const int16_t* samples,
+                                    size_t num_samples, int num_threads,
+                                    float scale, float* features,
+                                    size_t* num_frames) {
+  OutputFloat output;
+  output.features = features;
+  output.scale = scale;
+  return ProcessRecording(state, samples, num_samples, num_threads, output,
+                          num_frames);
+}
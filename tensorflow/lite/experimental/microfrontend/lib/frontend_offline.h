@@ -0,0 +1,69 @@
+/* Copyright 2026 The pymicro-features Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef TENSORFLOW_LITE_EXPERIMENTAL_MICROFRONTEND_LIB_FRONTEND_OFFLINE_H_
+#define TENSORFLOW_LITE_EXPERIMENTAL_MICROFRONTEND_LIB_FRONTEND_OFFLINE_H_
+
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "tensorflow/lite/experimental/microfrontend/lib/frontend.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Offline extraction of a whole recording at once. The window, FFT,
+// filterbank and square roots of a frame only depend on its own samples, so
+// worker threads take them on for chunks of frames in any order. Only the
+// noise reduction carries state from one frame to the next, and the calling
+// thread runs it, the gain control and the log scale on each chunk in frame
+// order as soon as the chunk is ready, in between taking chunks of its own.
+// The features are bit-identical to feeding the samples to
+// FrontendProcessSamples(), and the state is left the same way, so that
+// streaming can carry on with the samples that follow.
+//
+// The state must not have buffered any samples yet, as after
+// FrontendPopulateState() or FrontendReset(). The float engine and extra
+// heads are not supported.
+
+// Returns the number of feature vectors the recording gives, the same as
+// FrontendProcessSamples() would produce from the state. With an emission
+// stride, only the emitted frames count.
+size_t FrontendNumFrames(const struct FrontendState* state,
+                         size_t num_samples);
+
+// Computes the features of the recording into features, with those of the
+// f-th emitted frame at features + f * filterbank.num_channels, using up to
+// num_threads threads, the calling one included. A num_threads of 0 or less
+// uses one per core. Sets *num_frames to FrontendNumFrames(). Returns 0 on
+// failure.
+int FrontendProcessRecording(struct FrontendState* state,
+                             const int16_t* samples, size_t num_samples,
+                             int num_threads, uint16_t* features,
+                             size_t* num_frames);
+
+// Same as FrontendProcessRecording(), but the features are converted to
+// float and multiplied by scale, as in FrontendProcessSamplesToFloat().
+int FrontendProcessRecordingToFloat(struct FrontendState* state,
+                                    const int16_t* samples,
+                                    size_t num_samples, int num_threads,
+                                    float scale, float* features,
+                                    size_t* num_frames);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif  // TENSORFLOW_LITE_EXPERIMENTAL_MICROFRONTEND_LIB_FRONTEND_OFFLINE_H_
@@ -0,0 +1,237 @@
+/* Copyright 2026 The pymicro-features Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tensorflow/lite/experimental/microfrontend/lib/frontend_offline.h"
+
+#include "tensorflow/lite/experimental/microfrontend/lib/frontend_util.h"
+#include "tensorflow/lite/micro/testing/micro_test.h"
+
+namespace {
+
+const int kSampleRate = 16000;
+const float kFloatScale = 0.0390625f;
+// Samples streamed after the recording, to check the state it leaves.
+const size_t kTailSamples = 1000;
+
+void FillConfig(struct FrontendConfig* config) {
+  FrontendFillConfigWithDefaults(config);
+  config->pcan_gain_control.enable_pcan = true;
+}
+
+// Random audio with louder and quieter stretches, so the noise estimates
+// keep changing.
+int16_t* RandomAudio(size_t num_samples) {
+  int16_t* audio = new int16_t[num_samples];
+  uint32_t seed = 23;
+  size_t i;
+  for (i = 0; i < num_samples; ++i) {
+    seed = seed * 1664525u + 1013904223u;
+    audio[i] = static_cast<int16_t>(seed >> 16) / ((i / 1000) % 7 + 1);
+  }
+  return audio;
+}
+
+// Feeds the samples to FrontendProcessSamples(), or to
+// FrontendProcessSamplesToFloat() with kFloatScale, and stores the features
+// of each frame at features + frame * num_channels. Returns the number of
+// frames.
+size_t StreamSamples(struct FrontendState* state, const int16_t* samples,
+                     size_t num_samples, uint16_t* features) {
+  const int num_channels = state->filterbank.num_channels;
+  size_t num_frames = 0;
+  while (num_samples > 0) {
+    size_t num_samples_read;
+    struct FrontendOutput output =
+        FrontendProcessSamples(state, samples, num_samples, &num_samples_read);
+    size_t i;
+    for (i = 0; i < output.size; ++i) {
+      features[num_frames * num_channels + i] = output.values[i];
+    }
+    num_frames += output.size > 0;
+    samples += num_samples_read;
+    num_samples -= num_samples_read;
+  }
+  return num_frames;
+}
+
+size_t StreamSamples(struct FrontendState* state, const int16_t* samples,
+                     size_t num_samples, float* features) {
+  const int num_channels = state->filterbank.num_channels;
+  size_t num_frames = 0;
+  while (num_samples > 0) {
+    size_t num_samples_read;
+    num_frames += FrontendProcessSamplesToFloat(
+                      state, samples, num_samples, &num_samples_read,
+                      kFloatScale, features + num_frames * num_channels) > 0;
+    samples += num_samples_read;
+    num_samples -= num_samples_read;
+  }
+  return num_frames;
+}
+
+int ProcessRecording(struct FrontendState* state, const int16_t* samples,
+                     size_t num_samples, int num_threads, uint16_t* features,
+                     size_t* num_frames) {
+  return FrontendProcessRecording(state, samples, num_samples, num_threads,
+                                  features, num_frames);
+}
+
+int ProcessRecording(struct FrontendState* state, const int16_t* samples,
+                     size_t num_samples, int num_threads, float* features,
+                     size_t* num_frames) {
+  return FrontendProcessRecordingToFloat(state, samples, num_samples,
+                                         num_threads, kFloatScale, features,
+                                         num_frames);
+}
+
+// Checks the features of a recording of num_samples samples against
+// streaming, and then the features of kTailSamples samples streamed after
+// it.
+template <class Value>
+void CheckMatchesStreaming(const struct FrontendConfig* config,
+                           size_t num_samples, int num_threads) {
+  const int num_channels = config->filterbank.num_channels;
+  const size_t max_values =
+      ((num_samples + kTailSamples) / (kSampleRate / 100) + 1) * num_channels;
+  int16_t* audio = RandomAudio(num_samples + kTailSamples);
+  Value* expected = new Value[max_values];
+  Value* values = new Value[max_values];
+  struct FrontendState streaming;
+  struct FrontendState offline;
+  TF_LITE_MICRO_EXPECT(FrontendPopulateState(config, &streaming, kSampleRate));
+  TF_LITE_MICRO_EXPECT(FrontendPopulateState(config, &offline, kSampleRate));
+
+  const size_t num_frames =
+      StreamSamples(&streaming, audio, num_samples, expected);
+  TF_LITE_MICRO_EXPECT_EQ(FrontendNumFrames(&offline, num_samples),
+                          num_frames);
+  size_t offline_frames = 0;
+  TF_LITE_MICRO_EXPECT(ProcessRecording(&offline, audio, num_samples,
+                                        num_threads, values, &offline_frames));
+  TF_LITE_MICRO_EXPECT_EQ(offline_frames, num_frames);
+  size_t i;
+  for (i = 0; i < num_frames * num_channels; ++i) {
+    TF_LITE_MICRO_EXPECT_EQ(values[i], expected[i]);
+  }
+
+  const size_t tail_frames = StreamSamples(
+      &streaming, audio + num_samples, kTailSamples, expected);
+  TF_LITE_MICRO_EXPECT_EQ(StreamSamples(&offline, audio + num_samples,
+                                        kTailSamples, values),
+                          tail_frames);
+  TF_LITE_MICRO_EXPECT(tail_frames > 0);
+  for (i = 0; i < tail_frames * num_channels; ++i) {
+    TF_LITE_MICRO_EXPECT_EQ(values[i], expected[i]);
+  }
+
+  FrontendFreeStateContents(&offline);
+  FrontendFreeStateContents(&streaming);
+  delete[] values;
+  delete[] expected;
+  delete[] audio;
+}
+
+void CheckMatchesStreaming(const struct FrontendConfig* config) {
+  // No frames, one, a few chunks and a partial one, and enough chunks for
+  // the slots to be reused.
+  const size_t kNumSamples[] = {0, 479, 480, 2 * kSampleRate + 37,
+                                10 * kSampleRate};
+  const int kNumThreads[] = {1, 2, 3, 7};
+  size_t n;
+  for (n = 0; n < sizeof(kNumSamples) / sizeof(kNumSamples[0]); ++n) {
+    size_t t;
+    for (t = 0; t < sizeof(kNumThreads) / sizeof(kNumThreads[0]); ++t) {
+      CheckMatchesStreaming<uint16_t>(config, kNumSamples[n], kNumThreads[t]);
+      CheckMatchesStreaming<float>(config, kNumSamples[n], kNumThreads[t]);
+    }
+  }
+}
+
+}  // namespace
+
+TF_LITE_MICRO_TESTS_BEGIN
+
+TF_LITE_MICRO_TEST(FrontendOfflineTest_MatchesStreaming) {
+  struct FrontendConfig config;
+  FillConfig(&config);
+  CheckMatchesStreaming(&config);
+}
+
+TF_LITE_MICRO_TEST(FrontendOfflineTest_MatchesStreamingWithoutPcan) {
+  struct FrontendConfig config;
+  FillConfig(&config);
+  config.pcan_gain_control.enable_pcan = false;
+  CheckMatchesStreaming(&config);
+}
+
+TF_LITE_MICRO_TEST(FrontendOfflineTest_MatchesStreamingWithEmitStride) {
+  struct FrontendConfig config;
+  FillConfig(&config);
+  config.emit_stride = 3;
+  config.emit_phase = 1;
+  CheckMatchesStreaming(&config);
+}
+
+TF_LITE_MICRO_TEST(FrontendOfflineTest_OnePerCore) {
+  struct FrontendConfig config;
+  FillConfig(&config);
+  CheckMatchesStreaming<uint16_t>(&config, 3 * kSampleRate, 0);
+}
+
+TF_LITE_MICRO_TEST(FrontendOfflineTest_NeedsNoBufferedSamples) {
+  struct FrontendConfig config;
+  FillConfig(&config);
+  struct FrontendState state;
+  TF_LITE_MICRO_EXPECT(FrontendPopulateState(&config, &state, kSampleRate));
+  int16_t* audio = RandomAudio(kSampleRate);
+  size_t num_samples_read;
+  FrontendProcessSamples(&state, audio, 100, &num_samples_read);
+  uint16_t* features =
+      new uint16_t[FrontendNumFrames(&state, kSampleRate) *
+                   config.filterbank.num_channels];
+  size_t num_frames = 1;
+  TF_LITE_MICRO_EXPECT(!FrontendProcessRecording(&state, audio, kSampleRate,
+                                                 1, features, &num_frames));
+  TF_LITE_MICRO_EXPECT_EQ(num_frames, 0u);
+
+  FrontendReset(&state);
+  TF_LITE_MICRO_EXPECT(FrontendProcessRecording(&state, audio, kSampleRate, 1,
+                                                features, &num_frames));
+  TF_LITE_MICRO_EXPECT_EQ(num_frames, FrontendNumFrames(&state, kSampleRate));
+
+  delete[] features;
+  delete[] audio;
+  FrontendFreeStateContents(&state);
+}
+
+TF_LITE_MICRO_TEST(FrontendOfflineTest_NeedsFixedPoint) {
+  struct FrontendConfig config;
+  FillConfig(&config);
+  config.use_float_engine = true;
+  struct FrontendState state;
+  TF_LITE_MICRO_EXPECT(FrontendPopulateState(&config, &state, kSampleRate));
+  int16_t* audio = RandomAudio(kSampleRate);
+  uint16_t* features =
+      new uint16_t[FrontendNumFrames(&state, kSampleRate) *
+                   config.filterbank.num_channels];
+  size_t num_frames;
+  TF_LITE_MICRO_EXPECT(!FrontendProcessRecording(&state, audio, kSampleRate,
+                                                 1, features, &num_frames));
+
+  delete[] features;
+  delete[] audio;
+  FrontendFreeStateContents(&state);
+}
+
+TF_LITE_MICRO_TESTS_END
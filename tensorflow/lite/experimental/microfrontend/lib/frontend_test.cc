@@ -47,11 +47,174 @@ class FrontendTestConfig {
     config_.pcan_gain_control.gain_bits = 21;
     config_.log_scale.enable_log = true;
     config_.log_scale.scale_shift = 6;
+    config_.use_float_engine = false;
+    config_.incremental_fft = false;
+    config_.fft_backend = nullptr;
+    config_.num_heads = 0;
+    config_.heads = nullptr;
+    config_.emit_stride = 1;
+    config_.emit_phase = 0;
   }
 
   struct FrontendConfig config_;
 };
 
+const float kFloatScale = 0.0390625f;
+
+// Processes samples with FrontendProcessSamples() and copies the features
+// of a frame to features, or with FrontendProcessSamplesToFloat() and
+// kFloatScale. Returns the number of features.
+size_t ProcessSamples(struct FrontendState* state, const int16_t* samples,
+                      size_t num_samples, size_t* num_samples_read,
+                      uint16_t* features) {
+  struct FrontendOutput output =
+      FrontendProcessSamples(state, samples, num_samples, num_samples_read);
+  size_t i;
+  for (i = 0; i < output.size; ++i) {
+    features[i] = output.values[i];
+  }
+  return output.size;
+}
+
+size_t ProcessSamples(struct FrontendState* state, const int16_t* samples,
+                      size_t num_samples, size_t* num_samples_read,
+                      float* features) {
+  return FrontendProcessSamplesToFloat(state, samples, num_samples,
+                                       num_samples_read, kFloatScale,
+                                       features);
+}
+
+// Runs the frontend over num_samples samples of random audio, and stores the
+// features of each frame at values + frame * num_channels. Returns the
+// number of frames.
+template <class Value>
+int ProcessRandomAudio(const struct FrontendConfig* config, int sample_rate,
+                       int num_samples, Value* values) {
+  struct FrontendState state;
+  TF_LITE_MICRO_EXPECT(FrontendPopulateState(config, &state, sample_rate));
+  int16_t* audio = new int16_t[num_samples];
+  uint32_t seed = 19;
+  int i;
+  for (i = 0; i < num_samples; ++i) {
+    seed = seed * 1664525u + 1013904223u;
+    // Louder and quieter stretches, so the noise estimates keep changing.
+    audio[i] = static_cast<int16_t>(seed >> 16) / ((i / 1000) % 7 + 1);
+  }
+  int num_frames = 0;
+  int offset = 0;
+  while (offset < num_samples) {
+    size_t num_samples_read;
+    const size_t size = ProcessSamples(
+        &state, audio + offset, num_samples - offset, &num_samples_read,
+        values + num_frames * config->filterbank.num_channels);
+    offset += num_samples_read;
+    num_frames += size > 0;
+  }
+  delete[] audio;
+  FrontendFreeStateContents(&state);
+  return num_frames;
+}
+
+// Checks the float features against the 16-bit ones times kFloatScale.
+void CheckFloatMatchesScaled(const struct FrontendConfig* config,
+                             int sample_rate, int num_samples) {
+  const int num_channels = config->filterbank.num_channels;
+  // At most one frame per step of 10 ms.
+  const int max_values =
+      (num_samples / (sample_rate / 100) + 1) * num_channels;
+  uint16_t* expected = new uint16_t[max_values];
+  float* values = new float[max_values];
+
+  const int num_frames =
+      ProcessRandomAudio(config, sample_rate, num_samples, expected);
+  TF_LITE_MICRO_EXPECT(num_frames > 10);
+  TF_LITE_MICRO_EXPECT_EQ(
+      ProcessRandomAudio(config, sample_rate, num_samples, values),
+      num_frames);
+  int i;
+  for (i = 0; i < num_frames * num_channels; ++i) {
+    TF_LITE_MICRO_EXPECT_EQ(values[i], expected[i] * kFloatScale);
+  }
+
+  delete[] values;
+  delete[] expected;
+}
+
+// Checks that a frontend with an emission stride emits the features of
+// every stride-th frame of one without, for its own chain and a head. A
+// stride of 0 emits every frame.
+void CheckEmitStride(int stride, int phase) {
+  FrontendTestConfig config;
+  struct FrontendHeadConfig head;
+  FrontendFillHeadConfigWithDefaults(&head);
+  head.filterbank.num_channels = 3;
+  head.filterbank.lower_band_limit = 20.0;
+  head.filterbank.upper_band_limit = 300.0;
+  config.config_.num_heads = 1;
+  config.config_.heads = &head;
+  struct FrontendState every;
+  TF_LITE_MICRO_EXPECT(
+      FrontendPopulateState(&config.config_, &every, kSampleRate));
+  config.config_.emit_stride = stride;
+  config.config_.emit_phase = phase;
+  struct FrontendState strided;
+  TF_LITE_MICRO_EXPECT(
+      FrontendPopulateState(&config.config_, &strided, kSampleRate));
+  if (stride == 0) {
+    stride = 1;
+  }
+
+  int16_t audio[1000];
+  uint32_t seed = 29;
+  int i;
+  for (i = 0; i < 1000; ++i) {
+    seed = seed * 1664525u + 1013904223u;
+    audio[i] = static_cast<int16_t>(seed >> 16) / ((i / 100) % 4 + 1);
+  }
+
+  int num_frames = 0;
+  int num_emitted = 0;
+  size_t offset = 0;
+  while (offset < 1000) {
+    size_t num_samples_read;
+    struct FrontendOutput expected = FrontendProcessSamples(
+        &every, audio + offset, 1000 - offset, &num_samples_read);
+    size_t strided_read;
+    struct FrontendOutput output = FrontendProcessSamples(
+        &strided, audio + offset, 1000 - offset, &strided_read);
+    TF_LITE_MICRO_EXPECT_EQ(strided_read, num_samples_read);
+    offset += num_samples_read;
+    if (expected.size == 0) {
+      TF_LITE_MICRO_EXPECT_EQ(output.size, 0u);
+      continue;
+    }
+    if (num_frames++ % stride != phase) {
+      // The head has no features of a skipped frame either.
+      TF_LITE_MICRO_EXPECT_EQ(output.size, 0u);
+      TF_LITE_MICRO_EXPECT_EQ(strided.heads[0].output.size, 0u);
+      TF_LITE_MICRO_EXPECT(strided.heads[0].output.values == nullptr);
+      continue;
+    }
+    ++num_emitted;
+    TF_LITE_MICRO_EXPECT_EQ(output.size, expected.size);
+    size_t c;
+    for (c = 0; c < output.size; ++c) {
+      TF_LITE_MICRO_EXPECT_EQ(output.values[c], expected.values[c]);
+    }
+    TF_LITE_MICRO_EXPECT_EQ(strided.heads[0].output.size,
+                            every.heads[0].output.size);
+    for (c = 0; c < every.heads[0].output.size; ++c) {
+      TF_LITE_MICRO_EXPECT_EQ(strided.heads[0].output.values[c],
+                              every.heads[0].output.values[c]);
+    }
+  }
+  TF_LITE_MICRO_EXPECT(num_frames > 90);
+  TF_LITE_MICRO_EXPECT_EQ(num_emitted, (num_frames - phase - 1) / stride + 1);
+
+  FrontendFreeStateContents(&strided);
+  FrontendFreeStateContents(&every);
+}
+
 }  // namespace
 
 TF_LITE_MICRO_TESTS_BEGIN
@@ -126,4 +289,146 @@ TF_LITE_MICRO_TEST(FrontendTest_CheckNotEnoughSamples) {
   FrontendFreeStateContents(&state);
 }
 
+TF_LITE_MICRO_TEST(FrontendTest_FloatOutputMatchesScaled) {
+  FrontendTestConfig config;
+  CheckFloatMatchesScaled(&config.config_, kSampleRate, 2000);
+
+  config.config_.window.size_ms = 30;
+  config.config_.filterbank.num_channels = 40;
+  config.config_.filterbank.lower_band_limit = 125.0;
+  config.config_.filterbank.upper_band_limit = 7500.0;
+  CheckFloatMatchesScaled(&config.config_, 16000, 16000);
+
+  // The float engine computes the square roots itself.
+  config.config_.use_float_engine = true;
+  CheckFloatMatchesScaled(&config.config_, 16000, 16000);
+
+  config.config_.use_float_engine = false;
+  config.config_.emit_stride = 3;
+  config.config_.emit_phase = 2;
+  CheckFloatMatchesScaled(&config.config_, 16000, 16000);
+}
+
+TF_LITE_MICRO_TEST(FrontendTest_HeadsMatchSeparateFrontends) {
+  FrontendTestConfig config;
+  // A second head with more channels in a narrower band, and one with the
+  // frontend's own chain.
+  struct FrontendHeadConfig heads[2];
+  FrontendFillHeadConfigWithDefaults(&heads[0]);
+  heads[0].filterbank.num_channels = 3;
+  heads[0].filterbank.lower_band_limit = 20.0;
+  heads[0].filterbank.upper_band_limit = 300.0;
+  heads[0].noise_reduction = config.config_.noise_reduction;
+  heads[0].pcan_gain_control = config.config_.pcan_gain_control;
+  heads[0].log_scale = config.config_.log_scale;
+  heads[1].filterbank = config.config_.filterbank;
+  heads[1].noise_reduction = config.config_.noise_reduction;
+  heads[1].pcan_gain_control = config.config_.pcan_gain_control;
+  heads[1].log_scale = config.config_.log_scale;
+
+  struct FrontendState separate[3];
+  TF_LITE_MICRO_EXPECT(
+      FrontendPopulateState(&config.config_, &separate[0], kSampleRate));
+  struct FrontendConfig head_config = config.config_;
+  head_config.filterbank = heads[0].filterbank;
+  TF_LITE_MICRO_EXPECT(
+      FrontendPopulateState(&head_config, &separate[1], kSampleRate));
+  TF_LITE_MICRO_EXPECT(
+      FrontendPopulateState(&config.config_, &separate[2], kSampleRate));
+
+  config.config_.num_heads = 2;
+  config.config_.heads = heads;
+  struct FrontendState state;
+  TF_LITE_MICRO_EXPECT(
+      FrontendPopulateState(&config.config_, &state, kSampleRate));
+  TF_LITE_MICRO_EXPECT_EQ(state.num_heads, 2);
+
+  // Random audio, so the noise estimates and gains keep changing.
+  int16_t audio[1000];
+  uint32_t seed = 17;
+  int i;
+  for (i = 0; i < 1000; ++i) {
+    seed = seed * 1664525u + 1013904223u;
+    audio[i] = static_cast<int16_t>(seed >> 16) / ((i / 100) % 4 + 1);
+  }
+
+  int num_frames = 0;
+  size_t offset = 0;
+  while (offset < 1000) {
+    size_t num_samples_read;
+    struct FrontendOutput output = FrontendProcessSamples(
+        &state, audio + offset, 1000 - offset, &num_samples_read);
+    struct FrontendOutput expected[3];
+    int s;
+    for (s = 0; s < 3; ++s) {
+      size_t separate_read;
+      expected[s] = FrontendProcessSamples(
+          &separate[s], audio + offset, 1000 - offset, &separate_read);
+      TF_LITE_MICRO_EXPECT_EQ(separate_read, num_samples_read);
+    }
+    offset += num_samples_read;
+    if (output.size == 0) {
+      continue;
+    }
+    ++num_frames;
+    const struct FrontendOutput actual[3] = {output, state.heads[0].output,
+                                             state.heads[1].output};
+    for (s = 0; s < 3; ++s) {
+      TF_LITE_MICRO_EXPECT_EQ(actual[s].size, expected[s].size);
+      size_t c;
+      for (c = 0; c < actual[s].size; ++c) {
+        TF_LITE_MICRO_EXPECT_EQ(actual[s].values[c], expected[s].values[c]);
+      }
+    }
+  }
+  TF_LITE_MICRO_EXPECT(num_frames > 90);
+
+  FrontendFreeStateContents(&state);
+  for (i = 0; i < 3; ++i) {
+    FrontendFreeStateContents(&separate[i]);
+  }
+}
+
+TF_LITE_MICRO_TEST(FrontendTest_EmitStrideKeepsEveryNthFrame) {
+  int stride;
+  for (stride = 1; stride <= 3; ++stride) {
+    int phase;
+    for (phase = 0; phase < stride; ++phase) {
+      CheckEmitStride(stride, phase);
+    }
+  }
+}
+
+TF_LITE_MICRO_TEST(FrontendTest_ZeroEmitStrideEmitsEveryFrame) {
+  CheckEmitStride(0, 0);
+}
+
+TF_LITE_MICRO_TEST(FrontendTest_EmitPhaseWithinStride) {
+  const int kStrides[] = {2, 0, -1};
+  const int kPhases[] = {2, 1, 0};
+  int i;
+  for (i = 0; i < 3; ++i) {
+    FrontendTestConfig config;
+    config.config_.emit_stride = kStrides[i];
+    config.config_.emit_phase = kPhases[i];
+    struct FrontendState state;
+    TF_LITE_MICRO_EXPECT(
+        !FrontendPopulateState(&config.config_, &state, kSampleRate));
+    FrontendFreeStateContents(&state);
+  }
+}
+
+TF_LITE_MICRO_TEST(FrontendTest_HeadsNeedFixedPoint) {
+  FrontendTestConfig config;
+  struct FrontendHeadConfig head;
+  FrontendFillHeadConfigWithDefaults(&head);
+  config.config_.use_float_engine = true;
+  config.config_.num_heads = 1;
+  config.config_.heads = &head;
+  struct FrontendState state;
+  TF_LITE_MICRO_EXPECT(
+      !FrontendPopulateState(&config.config_, &state, kSampleRate));
+  FrontendFreeStateContents(&state);
+}
+
 TF_LITE_MICRO_TESTS_END
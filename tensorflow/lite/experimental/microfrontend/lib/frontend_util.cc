@@ -25,18 +25,74 @@ void FrontendFillConfigWithDefaults(struct FrontendConfig* config) {
   NoiseReductionFillConfigWithDefaults(&config->noise_reduction);
   PcanGainControlFillConfigWithDefaults(&config->pcan_gain_control);
   LogScaleFillConfigWithDefaults(&config->log_scale);
+  config->use_float_engine = 0;
+  config->incremental_fft = 0;
+  config->fft_backend = NULL;
+  config->num_heads = 0;
+  config->heads = NULL;
+  config->emit_stride = 1;
+  config->emit_phase = 0;
+}
+
+void FrontendFillHeadConfigWithDefaults(struct FrontendHeadConfig* config) {
+  FilterbankFillConfigWithDefaults(&config->filterbank);
+  NoiseReductionFillConfigWithDefaults(&config->noise_reduction);
+  PcanGainControlFillConfigWithDefaults(&config->pcan_gain_control);
+  LogScaleFillConfigWithDefaults(&config->log_scale);
+}
+
+static int PopulateHead(const struct FrontendHeadConfig* config,
+                        struct FrontendHeadState* head, int sample_rate,
+                        int fft_size) {
+  if (!FilterbankPopulateState(&config->filterbank, &head->filterbank,
+                               sample_rate, fft_size / 2 + 1)) {
+    fprintf(stderr, "Failed to populate head filterbank state\n");
+    return 0;
+  }
+  if (!NoiseReductionPopulateState(&config->noise_reduction,
+                                   &head->noise_reduction,
+                                   head->filterbank.num_channels)) {
+    fprintf(stderr, "Failed to populate head noise reduction state\n");
+    return 0;
+  }
+  int input_correction_bits =
+      MostSignificantBit32(fft_size) - 1 - (kFilterbankBits / 2);
+  if (!PcanGainControlPopulateState(
+          &config->pcan_gain_control, &head->pcan_gain_control,
+          head->noise_reduction.estimate, head->filterbank.num_channels,
+          head->noise_reduction.smoothing_bits, input_correction_bits)) {
+    fprintf(stderr, "Failed to populate head pcan gain control state\n");
+    return 0;
+  }
+  if (!LogScalePopulateState(&config->log_scale, &head->log_scale)) {
+    fprintf(stderr, "Failed to populate head log scale state\n");
+    return 0;
+  }
+  return 1;
 }
 
 int FrontendPopulateState(const struct FrontendConfig* config,
                           struct FrontendState* state, int sample_rate) {
   memset(state, 0, sizeof(*state));
 
+  // A stride of 0, as in a zeroed config, emits every frame like 1.
+  const int emit_stride = config->emit_stride > 1 ? config->emit_stride : 1;
+  if (config->emit_stride < 0 || config->emit_phase < 0 ||
+      config->emit_phase >= emit_stride) {
+    fprintf(stderr, "Emit phase %d is not within a stride of %d frames\n",
+            config->emit_phase, config->emit_stride);
+    return 0;
+  }
+  state->emit_stride = config->emit_stride;
+  state->emit_phase = config->emit_phase;
+
   if (!WindowPopulateState(&config->window, &state->window, sample_rate)) {
     fprintf(stderr, "Failed to populate window state\n");
     return 0;
   }
 
-  if (!FftPopulateState(&state->fft, state->window.size)) {
+  if (!FftPopulateStateWithBackend(&state->fft, state->window.size,
+                                   config->fft_backend)) {
     fprintf(stderr, "Failed to populate fft state\n");
     return 0;
   }
@@ -47,6 +103,24 @@ int FrontendPopulateState(const struct FrontendConfig* config,
     fprintf(stderr, "Failed to populate filterbank state\n");
     return 0;
   }
+  // The filterbank only reads the bins in its band.
+  state->fft.output_start_index = state->filterbank.start_index;
+  state->fft.output_end_index = state->filterbank.end_index;
+
+  if (config->use_float_engine) {
+    state->float_spectrum = (struct FloatSpectrumState*)malloc(
+        sizeof(*state->float_spectrum));
+    if (state->float_spectrum == NULL) {
+      fprintf(stderr, "Failed to allocate float spectrum state\n");
+      return 0;
+    }
+    if (!FloatSpectrumPopulateState(state->float_spectrum, &state->window,
+                                    &state->filterbank, state->fft.fft_size,
+                                    config->incremental_fft)) {
+      fprintf(stderr, "Failed to populate float spectrum state\n");
+      return 0;
+    }
+  }
 
   if (!NoiseReductionPopulateState(&config->noise_reduction,
                                    &state->noise_reduction,
@@ -70,6 +144,37 @@ int FrontendPopulateState(const struct FrontendConfig* config,
     return 0;
   }
 
+  if (config->num_heads > 0) {
+    if (config->use_float_engine) {
+      fprintf(stderr, "Extra heads are not supported with the float engine\n");
+      return 0;
+    }
+    state->heads = (struct FrontendHeadState*)calloc(config->num_heads,
+                                                     sizeof(*state->heads));
+    if (state->heads == NULL) {
+      fprintf(stderr, "Failed to allocate frontend heads\n");
+      return 0;
+    }
+    state->num_heads = config->num_heads;
+    int i;
+    for (i = 0; i < config->num_heads; ++i) {
+      struct FrontendHeadState* head = &state->heads[i];
+      if (!PopulateHead(&config->heads[i], head, sample_rate,
+                        state->fft.fft_size)) {
+        return 0;
+      }
+      // The transform covers the bands of every head.
+      const size_t start_index = head->filterbank.start_index;
+      const size_t end_index = head->filterbank.end_index;
+      if (start_index < state->fft.output_start_index) {
+        state->fft.output_start_index = start_index;
+      }
+      if (end_index > state->fft.output_end_index) {
+        state->fft.output_end_index = end_index;
+      }
+    }
+  }
+
   FrontendReset(state);
 
   // All good, return a true value.
@@ -82,4 +187,20 @@ void FrontendFreeStateContents(struct FrontendState* state) {
   FilterbankFreeStateContents(&state->filterbank);
   NoiseReductionFreeStateContents(&state->noise_reduction);
   PcanGainControlFreeStateContents(&state->pcan_gain_control);
+  if (state->float_spectrum != NULL) {
+    FloatSpectrumFreeStateContents(state->float_spectrum);
+    free(state->float_spectrum);
+    state->float_spectrum = NULL;
+  }
+  if (state->heads != NULL) {
+    int i;
+    for (i = 0; i < state->num_heads; ++i) {
+      FilterbankFreeStateContents(&state->heads[i].filterbank);
+      NoiseReductionFreeStateContents(&state->heads[i].noise_reduction);
+      PcanGainControlFreeStateContents(&state->heads[i].pcan_gain_control);
+    }
+    free(state->heads);
+    state->heads = NULL;
+    state->num_heads = 0;
+  }
 }
@@ -17,6 +17,7 @@ limitations under the License.
 
 #include "tensorflow/lite/experimental/microfrontend/lib/fft_util.h"
 #include "tensorflow/lite/experimental/microfrontend/lib/filterbank_util.h"
+#include "tensorflow/lite/experimental/microfrontend/lib/float_spectrum_util.h"
 #include "tensorflow/lite/experimental/microfrontend/lib/frontend.h"
 #include "tensorflow/lite/experimental/microfrontend/lib/log_scale_util.h"
 #include "tensorflow/lite/experimental/microfrontend/lib/noise_reduction_util.h"
@@ -27,17 +28,49 @@ limitations under the License.
 extern "C" {
 #endif
 
+// The stages of an extra head (see FrontendHeadState).
+struct FrontendHeadConfig {
+  struct FilterbankConfig filterbank;
+  struct NoiseReductionConfig noise_reduction;
+  struct PcanGainControlConfig pcan_gain_control;
+  struct LogScaleConfig log_scale;
+};
+
 struct FrontendConfig {
   struct WindowConfig window;
   struct FilterbankConfig filterbank;
   struct NoiseReductionConfig noise_reduction;
   struct PcanGainControlConfig pcan_gain_control;
   struct LogScaleConfig log_scale;
+  // Run the window through filterbank stages in single precision (see
+  // float_spectrum.h) instead of fixed point.
+  int use_float_engine;
+  // With the float engine, run the innermost transform stage on each part of
+  // the next frame as it arrives, instead of all at once when the frame is
+  // complete. This lowers the cost of the completing call when samples come
+  // in chunks smaller than the window step.
+  int incremental_fft;
+  // Name of the registered FFT backend to use (see fft_backend.h), or NULL to
+  // pick the preferred one for the transform size.
+  const char* fft_backend;
+  // Extra chains that share the window and FFT, for models with different
+  // filterbanks on the same audio. Not supported with the float engine.
+  int num_heads;
+  const struct FrontendHeadConfig* heads;
+  // Emit the features of every emit_stride-th frame only, starting with
+  // frame emit_phase, for models that read every few frames. The other
+  // frames only update the noise estimates, skipping the gain control and
+  // log. A stride of 1 or 0 emits every frame, and the phase must then be 0.
+  int emit_stride;
+  int emit_phase;
 };
 
 // Fills the frontendConfig with "sane" defaults.
 void FrontendFillConfigWithDefaults(struct FrontendConfig* config);
 
+// Fills a head config with the same defaults as the frontend's own chain.
+void FrontendFillHeadConfigWithDefaults(struct FrontendHeadConfig* config);
+
 // Allocates any buffers.
 int FrontendPopulateState(const struct FrontendConfig* config,
                           struct FrontendState* state, int sample_rate);
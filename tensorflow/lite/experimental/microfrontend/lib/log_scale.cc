@@ -15,7 +15,9 @@ limitations under the License.
 #include "tensorflow/lite/experimental/microfrontend/lib/log_scale.h"
 
 #include "tensorflow/lite/experimental/microfrontend/lib/bits.h"
+#include "tensorflow/lite/experimental/microfrontend/lib/cpu_features.h"
 #include "tensorflow/lite/experimental/microfrontend/lib/log_lut.h"
+#include "tensorflow/lite/experimental/microfrontend/lib/log_scale_dispatch.h"
 
 #define kuint16max 0x0000FFFF
 
@@ -57,27 +59,71 @@ static uint32_t Log(const uint32_t x, const uint32_t scale_shift) {
   return loge_scaled;
 }
 
-uint16_t* LogScaleApply(struct LogScaleState* state, uint32_t* signal,
-                        int signal_size, int correction_bits) {
+static uint16_t Saturate(const uint32_t value) {
+  return (value < kuint16max) ? value : kuint16max;
+}
+
+static uint16_t SaturatedLog(const uint32_t value, const uint32_t scale_shift) {
+  return (value > 1) ? Saturate(Log(value, scale_shift)) : 0;
+}
+
+// The scalar kernel. The branches on enable_log and on the sign of the
+// correction bits are taken once per call rather than once per channel.
+static void Apply(struct LogScaleState* state, uint32_t* signal,
+                  int signal_size, int correction_bits) {
   const int scale_shift = state->scale_shift;
   uint16_t* output = (uint16_t*)signal;
-  uint16_t* ret = output;
   int i;
-  for (i = 0; i < signal_size; ++i) {
-    uint32_t value = *signal++;
-    if (state->enable_log) {
-      if (correction_bits < 0) {
-        value >>= -correction_bits;
-      } else {
-        value <<= correction_bits;
-      }
-      if (value > 1) {
-        value = Log(value, scale_shift);
-      } else {
-        value = 0;
-      }
+  if (!state->enable_log) {
+    for (i = 0; i < signal_size; ++i) {
+      output[i] = Saturate(signal[i]);
+    }
+  } else if (correction_bits < 0) {
+    const int shift = -correction_bits;
+    for (i = 0; i < signal_size; ++i) {
+      output[i] = SaturatedLog(signal[i] >> shift, scale_shift);
+    }
+  } else {
+    for (i = 0; i < signal_size; ++i) {
+      output[i] = SaturatedLog(signal[i] << correction_bits, scale_shift);
     }
-    *output++ = (value < kuint16max) ? value : kuint16max;
   }
-  return ret;
+}
+
+// Converting the 16-bit values in a second loop measured quicker than in the
+// loop above, as the compiler vectorizes it.
+static void ApplyToFloat(struct LogScaleState* state, uint32_t* signal,
+                         int signal_size, int correction_bits, float scale,
+                         float* output) {
+  Apply(state, signal, signal_size, correction_bits);
+  const uint16_t* values = (const uint16_t*)signal;
+  int i;
+  for (i = 0; i < signal_size; ++i) {
+    output[i] = values[i] * scale;
+  }
+}
+
+static const struct LogScaleKernelSet kScalarKernels = {Apply, ApplyToFloat};
+
+const struct LogScaleKernelSet* const kLogScaleScalarKernels = &kScalarKernels;
+
+const struct LogScaleKernelSet* LogScaleKernelsForTier(int tier) {
+  return CPU_TIER_SELECT(tier, kLogScaleScalarKernels,
+                         kLogScaleSse41Kernels, kLogScaleAvx2Kernels,
+                         kLogScaleAvx512Kernels);
+}
+
+uint16_t* LogScaleApply(struct LogScaleState* state, uint32_t* signal,
+                        int signal_size, int correction_bits) {
+  LogScaleKernelsForTier(CpuActiveTier())
+      ->apply(state, signal, signal_size, correction_bits);
+  return (uint16_t*)signal;
+}
+
+void LogScaleApplyToFloat(struct LogScaleState* state, uint32_t* signal,
+                          int signal_size, int correction_bits, float scale,
+                          float* output) {
+  LogScaleKernelsForTier(CpuActiveTier())
+      ->apply_to_float(state, signal, signal_size, correction_bits, scale,
+                       output);
 }
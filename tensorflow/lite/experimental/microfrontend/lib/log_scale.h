@@ -32,6 +32,14 @@ struct LogScaleState {
 uint16_t* LogScaleApply(struct LogScaleState* state, uint32_t* signal,
                         int signal_size, int correction_bits);
 
+// Same as LogScaleApply(), but the 16-bit values are converted to float,
+// multiplied by scale and written to output, which has room for signal_size
+// values. The SIMD kernels do so in the same pass as the log. The signal
+// array may be modified as well.
+void LogScaleApplyToFloat(struct LogScaleState* state, uint32_t* signal,
+                          int signal_size, int correction_bits, float scale,
+                          float* output);
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif
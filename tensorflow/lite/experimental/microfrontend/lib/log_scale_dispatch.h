@@ -0,0 +1,53 @@
+/* Copyright 2026 The pymicro-features Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef TENSORFLOW_LITE_EXPERIMENTAL_MICROFRONTEND_LIB_LOG_SCALE_DISPATCH_H_
+#define TENSORFLOW_LITE_EXPERIMENTAL_MICROFRONTEND_LIB_LOG_SCALE_DISPATCH_H_
+
+#include <stdint.h>
+
+#include "tensorflow/lite/experimental/microfrontend/lib/cpu_features.h"
+#include "tensorflow/lite/experimental/microfrontend/lib/log_scale.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// The log scale kernels built for one CPU tier (see cpu_features.h).
+// log_scale.cc holds the scalar set, and log_scale_<tier>.cc the others.
+struct LogScaleKernelSet {
+  // LogScaleApply(), with the 16-bit output written over the signal.
+  void (*apply)(struct LogScaleState* state, uint32_t* signal,
+                int signal_size, int correction_bits);
+  // LogScaleApplyToFloat().
+  void (*apply_to_float)(struct LogScaleState* state, uint32_t* signal,
+                         int signal_size, int correction_bits, float scale,
+                         float* output);
+};
+
+extern const struct LogScaleKernelSet* const kLogScaleScalarKernels;
+#ifdef CPU_FEATURES_X86
+extern const struct LogScaleKernelSet* const kLogScaleSse41Kernels;
+extern const struct LogScaleKernelSet* const kLogScaleAvx2Kernels;
+extern const struct LogScaleKernelSet* const kLogScaleAvx512Kernels;
+#endif
+
+// Returns the kernels for the given tier.
+const struct LogScaleKernelSet* LogScaleKernelsForTier(int tier);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif  // TENSORFLOW_LITE_EXPERIMENTAL_MICROFRONTEND_LIB_LOG_SCALE_DISPATCH_H_
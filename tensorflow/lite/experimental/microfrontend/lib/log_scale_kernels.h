@@ -0,0 +1,457 @@
+/* Copyright 2026 The pymicro-features Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef TENSORFLOW_LITE_EXPERIMENTAL_MICROFRONTEND_LIB_LOG_SCALE_KERNELS_H_
+#define TENSORFLOW_LITE_EXPERIMENTAL_MICROFRONTEND_LIB_LOG_SCALE_KERNELS_H_
+
+// C++-only SIMD kernels of LogScaleApply(), one channel per 32-bit lane.
+// Log() needs the position of the most significant bit of the value and the
+// 16 bits below it, which are read off the exponent and mantissa of the
+// value converted to float, as in pcan_gain_control_kernels.h: the
+// conversion is exact once values of 2^24 and up are shifted down by 8
+// bits, and the bits it drops are the ones Log2FractionPart() truncates.
+// The two kLogLut entries around the fraction are fetched together into one
+// lane: with 16-bit permutes over the table kept in registers on AVX-512,
+// and as one 32-bit word otherwise. The product with kLogCoeff needs up to
+// 37 bits, and is split into the products with the integer and the fraction
+// part of the log2, which both fit in 32 bits. The results are clamped to
+// kuint16max and packed to 16 bits, or converted to float and scaled with
+// the same single rounding as the scalar code.
+//
+// The including translation unit defines one of LOG_SCALE_USE_SSE41,
+// LOG_SCALE_USE_AVX2 and LOG_SCALE_USE_AVX512 and names its CPU tier with
+// LOG_SCALE_TIER, as filterbank_kernels.h does.
+
+#include <stdint.h>
+#include <string.h>
+
+#include "tensorflow/lite/experimental/microfrontend/lib/log_lut.h"
+#include "tensorflow/lite/experimental/microfrontend/lib/log_scale.h"
+#include "tensorflow/lite/experimental/microfrontend/lib/log_scale_dispatch.h"
+
+#if defined(LOG_SCALE_USE_AVX2) || defined(LOG_SCALE_USE_AVX512)
+#include <immintrin.h>
+#else
+#include <smmintrin.h>
+#endif
+
+namespace log_scale {
+inline namespace LOG_SCALE_TIER {
+
+// Each policy holds the lane operations of one instruction set. Masks are
+// whole lanes of ones, or mask registers on AVX-512.
+#if defined(LOG_SCALE_USE_SSE41)
+struct Ops {
+  typedef __m128i V;
+  typedef __m128i Mask;
+  static const int kLanes = 4;
+
+  static inline V Load(const uint32_t* values) {
+    return _mm_loadu_si128(reinterpret_cast<const __m128i*>(values));
+  }
+  // The first count lanes, for the channels past the last whole block.
+  static inline V LoadTail(const uint32_t* values, int count) {
+    uint32_t lanes[kLanes] = {0};
+    memcpy(lanes, values, count * sizeof(*values));
+    return Load(lanes);
+  }
+  // Lanes of at most kuint16max, packed to 16 bits.
+  static inline void Store16(uint16_t* output, V v) {
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(output),
+                     _mm_packus_epi32(v, v));
+  }
+  static inline void Store16Tail(uint16_t* output, V v, int count) {
+    uint16_t lanes[kLanes];
+    Store16(lanes, v);
+    memcpy(output, lanes, count * sizeof(*output));
+  }
+  // Lanes of at most kuint16max, converted to float and multiplied by
+  // scale.
+  typedef __m128 Scale;
+  static inline Scale SetScale(float scale) { return _mm_set1_ps(scale); }
+  static inline void StoreFloat(float* output, V v, Scale scale) {
+    _mm_storeu_ps(output, _mm_mul_ps(_mm_cvtepi32_ps(v), scale));
+  }
+  static inline void StoreFloatTail(float* output, V v, Scale scale,
+                                    int count) {
+    float lanes[kLanes];
+    StoreFloat(lanes, v, scale);
+    memcpy(output, lanes, count * sizeof(*output));
+  }
+
+  static inline V Set1(int32_t value) { return _mm_set1_epi32(value); }
+  static inline V Add(V a, V b) { return _mm_add_epi32(a, b); }
+  static inline V Sub(V a, V b) { return _mm_sub_epi32(a, b); }
+  static inline V MulLo(V a, V b) { return _mm_mullo_epi32(a, b); }
+  static inline V And(V a, V b) { return _mm_and_si128(a, b); }
+  static inline V MinUnsigned(V a, V b) { return _mm_min_epu32(a, b); }
+  static inline V ShiftLeft(V v, int count) {
+    return _mm_slli_epi32(v, count);
+  }
+  static inline V ShiftRight(V v, int count) {
+    return _mm_srli_epi32(v, count);
+  }
+  static inline V ShiftRightArithmetic(V v, int count) {
+    return _mm_srai_epi32(v, count);
+  }
+  static inline V ShiftLeft(V v, __m128i count) {
+    return _mm_sll_epi32(v, count);
+  }
+  static inline V ShiftRight(V v, __m128i count) {
+    return _mm_srl_epi32(v, count);
+  }
+  static inline Mask IsZero(V v) {
+    return _mm_cmpeq_epi32(v, _mm_setzero_si128());
+  }
+  static inline V Select(Mask mask, V if_true, V if_false) {
+    return _mm_blendv_epi8(if_false, if_true, mask);
+  }
+  // The bits of the lanes converted to float.
+  static inline V FloatBits(V v) {
+    return _mm_castps_si128(_mm_cvtepi32_ps(v));
+  }
+  // kLogLut[segment] | kLogLut[segment + 1] << 16 in each lane, from the
+  // table in registers where the instruction set keeps it there. There is no
+  // gather before AVX2.
+  struct Table {};
+  static inline Table LoadTable() { return Table(); }
+  static inline V LookupPair(const Table&, V segment) {
+    uint32_t pairs[kLanes];
+    memcpy(&pairs[0], kLogLut + _mm_cvtsi128_si32(segment), sizeof(*pairs));
+    memcpy(&pairs[1], kLogLut + _mm_extract_epi32(segment, 1),
+           sizeof(*pairs));
+    memcpy(&pairs[2], kLogLut + _mm_extract_epi32(segment, 2),
+           sizeof(*pairs));
+    memcpy(&pairs[3], kLogLut + _mm_extract_epi32(segment, 3),
+           sizeof(*pairs));
+    return Load(pairs);
+  }
+};
+#elif defined(LOG_SCALE_USE_AVX2)
+struct Ops {
+  typedef __m256i V;
+  typedef __m256i Mask;
+  static const int kLanes = 8;
+
+  static inline V Load(const uint32_t* values) {
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values));
+  }
+  static inline V LoadTail(const uint32_t* values, int count) {
+    const __m256i mask = _mm256_cmpgt_epi32(
+        _mm256_set1_epi32(count), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+    return _mm256_maskload_epi32(reinterpret_cast<const int*>(values), mask);
+  }
+  static inline __m128i Pack(V v) {
+    return _mm_packus_epi32(_mm256_castsi256_si128(v),
+                            _mm256_extracti128_si256(v, 1));
+  }
+  static inline void Store16(uint16_t* output, V v) {
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(output), Pack(v));
+  }
+  // There is no masked 16-bit store before AVX-512.
+  static inline void Store16Tail(uint16_t* output, V v, int count) {
+    uint16_t lanes[kLanes];
+    Store16(lanes, v);
+    memcpy(output, lanes, count * sizeof(*output));
+  }
+  typedef __m256 Scale;
+  static inline Scale SetScale(float scale) { return _mm256_set1_ps(scale); }
+  static inline void StoreFloat(float* output, V v, Scale scale) {
+    _mm256_storeu_ps(output, _mm256_mul_ps(_mm256_cvtepi32_ps(v), scale));
+  }
+  static inline void StoreFloatTail(float* output, V v, Scale scale,
+                                    int count) {
+    const __m256i mask = _mm256_cmpgt_epi32(
+        _mm256_set1_epi32(count), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+    _mm256_maskstore_ps(output, mask,
+                        _mm256_mul_ps(_mm256_cvtepi32_ps(v), scale));
+  }
+
+  static inline V Set1(int32_t value) { return _mm256_set1_epi32(value); }
+  static inline V Add(V a, V b) { return _mm256_add_epi32(a, b); }
+  static inline V Sub(V a, V b) { return _mm256_sub_epi32(a, b); }
+  static inline V MulLo(V a, V b) { return _mm256_mullo_epi32(a, b); }
+  static inline V And(V a, V b) { return _mm256_and_si256(a, b); }
+  static inline V MinUnsigned(V a, V b) { return _mm256_min_epu32(a, b); }
+  static inline V ShiftLeft(V v, int count) {
+    return _mm256_slli_epi32(v, count);
+  }
+  static inline V ShiftRight(V v, int count) {
+    return _mm256_srli_epi32(v, count);
+  }
+  static inline V ShiftRightArithmetic(V v, int count) {
+    return _mm256_srai_epi32(v, count);
+  }
+  static inline V ShiftLeft(V v, __m128i count) {
+    return _mm256_sll_epi32(v, count);
+  }
+  static inline V ShiftRight(V v, __m128i count) {
+    return _mm256_srl_epi32(v, count);
+  }
+  static inline Mask IsZero(V v) {
+    return _mm256_cmpeq_epi32(v, _mm256_setzero_si256());
+  }
+  static inline V Select(Mask mask, V if_true, V if_false) {
+    return _mm256_blendv_epi8(if_false, if_true, mask);
+  }
+  static inline V FloatBits(V v) {
+    return _mm256_castps_si256(_mm256_cvtepi32_ps(v));
+  }
+  struct Table {};
+  static inline Table LoadTable() { return Table(); }
+  static inline V LookupPair(const Table&, V segment) {
+    return _mm256_i32gather_epi32(reinterpret_cast<const int*>(kLogLut),
+                                  segment, 2);
+  }
+};
+#elif defined(LOG_SCALE_USE_AVX512)
+struct Ops {
+  typedef __m512i V;
+  typedef __mmask16 Mask;
+  static const int kLanes = 16;
+
+  static inline V Load(const uint32_t* values) {
+    return _mm512_loadu_si512(values);
+  }
+  static inline V LoadTail(const uint32_t* values, int count) {
+    return _mm512_maskz_loadu_epi32((1u << count) - 1, values);
+  }
+  static inline void Store16(uint16_t* output, V v) {
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(output),
+                        _mm512_cvtepi32_epi16(v));
+  }
+  static inline void Store16Tail(uint16_t* output, V v, int count) {
+    _mm512_mask_cvtepi32_storeu_epi16(output, (1u << count) - 1, v);
+  }
+  typedef __m512 Scale;
+  static inline Scale SetScale(float scale) { return _mm512_set1_ps(scale); }
+  static inline void StoreFloat(float* output, V v, Scale scale) {
+    _mm512_storeu_ps(output, _mm512_mul_ps(_mm512_cvtepi32_ps(v), scale));
+  }
+  static inline void StoreFloatTail(float* output, V v, Scale scale,
+                                    int count) {
+    _mm512_mask_storeu_ps(output, (1u << count) - 1,
+                          _mm512_mul_ps(_mm512_cvtepi32_ps(v), scale));
+  }
+
+  static inline V Set1(int32_t value) { return _mm512_set1_epi32(value); }
+  static inline V Add(V a, V b) { return _mm512_add_epi32(a, b); }
+  static inline V Sub(V a, V b) { return _mm512_sub_epi32(a, b); }
+  static inline V MulLo(V a, V b) { return _mm512_mullo_epi32(a, b); }
+  static inline V And(V a, V b) { return _mm512_and_si512(a, b); }
+  static inline V MinUnsigned(V a, V b) { return _mm512_min_epu32(a, b); }
+  static inline V ShiftLeft(V v, int count) {
+    return _mm512_slli_epi32(v, count);
+  }
+  static inline V ShiftRight(V v, int count) {
+    return _mm512_srli_epi32(v, count);
+  }
+  static inline V ShiftRightArithmetic(V v, int count) {
+    return _mm512_srai_epi32(v, count);
+  }
+  static inline V ShiftLeft(V v, __m128i count) {
+    return _mm512_sll_epi32(v, count);
+  }
+  static inline V ShiftRight(V v, __m128i count) {
+    return _mm512_srl_epi32(v, count);
+  }
+  static inline Mask IsZero(V v) { return _mm512_testn_epi32_mask(v, v); }
+  static inline V Select(Mask mask, V if_true, V if_false) {
+    return _mm512_mask_blend_epi32(mask, if_false, if_true);
+  }
+  static inline V FloatBits(V v) {
+    return _mm512_castps_si512(_mm512_cvtepi32_ps(v));
+  }
+  // Two 16-bit permutes over kLogLut[0..63] and kLogLut[64..127] look both
+  // entries up at once, with segment + 1 in the upper halves of the lanes.
+  // They measured quicker than a gather. The last entry, kLogLut[128], is
+  // 0.
+  struct Table {
+    __m512i low[2];
+    __m512i high[2];
+  };
+  static inline Table LoadTable() {
+    Table table;
+    table.low[0] = _mm512_loadu_si512(kLogLut);
+    table.low[1] = _mm512_loadu_si512(kLogLut + 32);
+    table.high[0] = _mm512_loadu_si512(kLogLut + 64);
+    table.high[1] = _mm512_loadu_si512(kLogLut + 96);
+    return table;
+  }
+  static inline V LookupPair(const Table& table, V segment) {
+    const __m512i index = _mm512_or_si512(
+        segment, _mm512_slli_epi32(_mm512_add_epi32(segment, Set1(1)), 16));
+    const __mmask32 high =
+        _mm512_test_epi16_mask(index, _mm512_set1_epi16(64));
+    const __mmask32 end =
+        _mm512_test_epi16_mask(index, _mm512_set1_epi16(128));
+    const __m512i low_pair =
+        _mm512_permutex2var_epi16(table.low[0], index, table.low[1]);
+    const __m512i high_pair =
+        _mm512_permutex2var_epi16(table.high[0], index, table.high[1]);
+    return _mm512_maskz_mov_epi16(
+        ~end, _mm512_mask_blend_epi16(high, low_pair, high_pair));
+  }
+};
+#endif
+
+// How LogScaleApply() treats the values before their log, which is the same
+// for the whole signal.
+enum Mode { kNoLog, kLogShiftRight, kLogShiftLeft };
+
+// Log() of each lane, for values of 2 and up.
+inline Ops::V Log(const Ops::Table& table, Ops::V x, __m128i scale_shift) {
+  const Ops::Mask small = Ops::IsZero(Ops::ShiftRight(x, 24));
+  const Ops::V bits =
+      Ops::FloatBits(Ops::Select(small, x, Ops::ShiftRight(x, 8)));
+  // A biased exponent of 127 is a most significant bit of 1.
+  const Ops::V integer =
+      Ops::Add(Ops::Sub(Ops::ShiftRight(bits, 23), Ops::Set1(127)),
+               Ops::Select(small, Ops::Set1(0), Ops::Set1(8)));
+  const Ops::V frac = Ops::And(Ops::ShiftRight(bits, 7), Ops::Set1(0xFFFF));
+
+  // Log2FractionPart().
+  const Ops::V pair = Ops::LookupPair(
+      table, Ops::ShiftRight(frac, kLogScaleLog2 - kLogSegmentsLog2));
+  const Ops::V c0 = Ops::And(pair, Ops::Set1(0xFFFF));
+  const Ops::V c1 = Ops::ShiftRight(pair, 16);
+  const Ops::V seg_offset = Ops::And(
+      frac, Ops::Set1((1 << (kLogScaleLog2 - kLogSegmentsLog2)) - 1));
+  const Ops::V rel_pos = Ops::ShiftRightArithmetic(
+      Ops::MulLo(Ops::Sub(c1, c0), seg_offset), kLogScaleLog2);
+  const Ops::V log2 = Ops::Add(Ops::ShiftLeft(integer, kLogScaleLog2),
+                               Ops::Add(Ops::Add(frac, c0), rel_pos));
+
+  // kLogCoeff * log2, rounded, as the sum of the products with both halves
+  // of log2.
+  const Ops::V coeff = Ops::Set1(kLogCoeff);
+  const Ops::V round = Ops::Set1(kLogScale / 2);
+  const Ops::V loge = Ops::Add(
+      Ops::MulLo(Ops::ShiftRight(log2, kLogScaleLog2), coeff),
+      Ops::ShiftRight(
+          Ops::Add(Ops::MulLo(Ops::And(log2, Ops::Set1(0xFFFF)), coeff),
+                   round),
+          kLogScaleLog2));
+  return Ops::ShiftRight(Ops::Add(Ops::ShiftLeft(loge, scale_shift), round),
+                         kLogScaleLog2);
+}
+
+// Where the results go: packed to 16 bits over the signal, or converted to
+// float and scaled.
+struct Output16 {
+  uint16_t* output;
+
+  template <bool kTail>
+  inline void Store(int first, Ops::V v, int count) const {
+    if (kTail) {
+      Ops::Store16Tail(output + first, v, count);
+    } else {
+      Ops::Store16(output + first, v);
+    }
+  }
+};
+struct OutputFloat {
+  float* output;
+  Ops::Scale scale;
+
+  template <bool kTail>
+  inline void Store(int first, Ops::V v, int count) const {
+    if (kTail) {
+      Ops::StoreFloatTail(output + first, v, scale, count);
+    } else {
+      Ops::StoreFloat(output + first, v, scale);
+    }
+  }
+};
+
+// Same as the scalar LogScaleApply() on a block of Ops::kLanes channels, or
+// on the count channels left over. The output of a block only overwrites
+// signal values that are already loaded.
+template <Mode kMode, bool kTail, class Output>
+inline void ApplyBlock(const Ops::Table& table, int first, int count,
+                       __m128i correction_shift, __m128i scale_shift,
+                       const uint32_t* signal, const Output& output) {
+  Ops::V value = kTail ? Ops::LoadTail(signal + first, count)
+                       : Ops::Load(signal + first);
+  if (kMode != kNoLog) {
+    value = kMode == kLogShiftRight
+                ? Ops::ShiftRight(value, correction_shift)
+                : Ops::ShiftLeft(value, correction_shift);
+    // Values of 0 and 1 have a log of 0.
+    value = Ops::Select(Ops::IsZero(Ops::ShiftRight(value, 1)), Ops::Set1(0),
+                        Log(table, value, scale_shift));
+  }
+  output.template Store<kTail>(
+      first, Ops::MinUnsigned(value, Ops::Set1(0xFFFF)), count);
+}
+
+// The blocks of the whole signal, with the shifts in the form the lane
+// shifts take.
+template <Mode kMode, class Output>
+void ApplyChannels(const uint32_t* signal, int signal_size,
+                   int correction_shift, int scale_shift,
+                   const Output& output) {
+  const __m128i correction = _mm_cvtsi32_si128(correction_shift);
+  const __m128i scale = _mm_cvtsi32_si128(scale_shift);
+  const Ops::Table table = Ops::LoadTable();
+  int i;
+  for (i = 0; i + Ops::kLanes <= signal_size; i += Ops::kLanes) {
+    ApplyBlock<kMode, false>(table, i, Ops::kLanes, correction, scale, signal,
+                             output);
+  }
+  if (i < signal_size) {
+    ApplyBlock<kMode, true>(table, i, signal_size - i, correction, scale,
+                            signal, output);
+  }
+}
+
+template <class Output>
+void ApplyToOutput(const struct LogScaleState* state, const uint32_t* signal,
+                   int signal_size, int correction_bits,
+                   const Output& output) {
+  if (!state->enable_log) {
+    ApplyChannels<kNoLog>(signal, signal_size, 0, 0, output);
+  } else if (correction_bits < 0) {
+    ApplyChannels<kLogShiftRight>(signal, signal_size, -correction_bits,
+                                  state->scale_shift, output);
+  } else {
+    ApplyChannels<kLogShiftLeft>(signal, signal_size, correction_bits,
+                                 state->scale_shift, output);
+  }
+}
+
+// Same as the scalar LogScaleApply().
+void Apply(struct LogScaleState* state, uint32_t* signal, int signal_size,
+           int correction_bits) {
+  Output16 output;
+  output.output = reinterpret_cast<uint16_t*>(signal);
+  ApplyToOutput(state, signal, signal_size, correction_bits, output);
+}
+
+// Same as the scalar LogScaleApplyToFloat().
+void ApplyToFloat(struct LogScaleState* state, uint32_t* signal,
+                  int signal_size, int correction_bits, float scale,
+                  float* output) {
+  OutputFloat float_output;
+  float_output.output = output;
+  float_output.scale = Ops::SetScale(scale);
+  ApplyToOutput(state, signal, signal_size, correction_bits, float_output);
+}
+
+const struct LogScaleKernelSet kKernelSet = {Apply, ApplyToFloat};
+
+}  // namespace LOG_SCALE_TIER
+}  // namespace log_scale
+
+#endif  // TENSORFLOW_LITE_EXPERIMENTAL_MICROFRONTEND_LIB_LOG_SCALE_KERNELS_H_
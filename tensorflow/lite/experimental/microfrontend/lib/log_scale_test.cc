@@ -14,6 +14,9 @@ limitations under the License.
 ==============================================================================*/
 #include "tensorflow/lite/experimental/microfrontend/lib/log_scale.h"
 
+#include <algorithm>
+
+#include "tensorflow/lite/experimental/microfrontend/lib/cpu_features.h"
 #include "tensorflow/lite/experimental/microfrontend/lib/log_scale_util.h"
 #include "tensorflow/lite/micro/testing/micro_test.h"
 
@@ -21,6 +24,85 @@ namespace {
 
 const int kScaleShift = 6;
 const int kCorrectionBits = -1;
+// Not a power of two, so the products are rounded.
+const float kFloatScale = 0.1f;
+
+uint32_t NextRandom(uint32_t* seed) {
+  *seed = *seed * 1664525u + 1013904223u;
+  return *seed;
+}
+
+// Checks every CPU tier against the scalar loop for num_frames frames of
+// num_channels channels. The values cover every bit length, with the ones
+// around each power of two and around 2^24, where the kernels change how
+// they find the bit length, and the ones that saturate. The float output of
+// every tier, scalar included, is checked against the 16-bit one as well.
+void CheckMatchesScalar(int enable_log, int scale_shift, int correction_bits,
+                        int num_channels, int num_frames) {
+  struct LogScaleState state;
+  state.enable_log = enable_log;
+  state.scale_shift = scale_shift;
+
+  const int active_tier = CpuActiveTier();
+  uint32_t* input = new uint32_t[num_channels];
+  uint32_t* expected = new uint32_t[num_channels];
+  uint32_t* signal = new uint32_t[num_channels];
+  float* float_output = new float[num_channels];
+  uint32_t seed = 29 + correction_bits;
+  int frame;
+  for (frame = 0; frame < num_frames; ++frame) {
+    int i;
+    for (i = 0; i < num_channels; ++i) {
+      const uint32_t value = NextRandom(&seed);
+      const int bit = NextRandom(&seed) % 32;
+      switch (frame % 3) {
+        case 0:
+          input[i] = value >> bit;
+          break;
+        case 1:
+          input[i] = (1u << bit) + (value % 3) - 1;
+          break;
+        default:
+          input[i] = (1u << 24) + (value % 512) - 256;
+          break;
+      }
+    }
+    input[0] = frame % 4;
+    input[num_channels - 1] = 0xFFFFFFFF - frame % 4;
+
+    TF_LITE_MICRO_EXPECT(CpuSetTier(kCpuTierScalar));
+    std::copy(input, input + num_channels, expected);
+    const uint16_t* expected_output =
+        LogScaleApply(&state, expected, num_channels, correction_bits);
+    int tier;
+    for (tier = kCpuTierScalar; tier <= CpuDetectTier(); ++tier) {
+      TF_LITE_MICRO_EXPECT(CpuSetTier(tier));
+      std::copy(input, input + num_channels, signal);
+      std::fill(float_output, float_output + num_channels, -1.0f);
+      LogScaleApplyToFloat(&state, signal, num_channels, correction_bits,
+                           kFloatScale, float_output);
+      for (i = 0; i < num_channels; ++i) {
+        TF_LITE_MICRO_EXPECT_EQ(float_output[i],
+                                expected_output[i] * kFloatScale);
+      }
+      if (tier == kCpuTierScalar) {
+        continue;
+      }
+      std::copy(input, input + num_channels, signal);
+      const uint16_t* output =
+          LogScaleApply(&state, signal, num_channels, correction_bits);
+      for (i = 0; i < num_channels; ++i) {
+        TF_LITE_MICRO_EXPECT_EQ(output[i], expected_output[i]);
+      }
+    }
+  }
+  CpuSetTier(active_tier);
+
+  delete[] float_output;
+  delete[] signal;
+  delete[] expected;
+  delete[] input;
+}
 
 }  // namespace
 
@@ -58,4 +140,13 @@ TF_LITE_MICRO_TEST(LogScaleTest_CheckOutputValuesNoLog) {
   }
 }
 
+TF_LITE_MICRO_TEST(LogScaleTest_SimdKernelsMatchScalar) {
+  // 37 channels leave a partial block on every tier.
+  CheckMatchesScalar(true, kScaleShift, kCorrectionBits, 37, 3000);
+  CheckMatchesScalar(true, kScaleShift, 0, 40, 1000);
+  CheckMatchesScalar(true, kScaleShift, 3, 80, 1000);
+  CheckMatchesScalar(true, 10, -5, 3, 1000);
+  CheckMatchesScalar(false, kScaleShift, kCorrectionBits, 37, 1000);
+}
+
 TF_LITE_MICRO_TESTS_END
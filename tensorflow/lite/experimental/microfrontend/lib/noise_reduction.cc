@@ -16,12 +16,15 @@ limitations under the License.
 
 #include <string.h>
 
-void NoiseReductionApply(struct NoiseReductionState* state, uint32_t* signal) {
+#include "tensorflow/lite/experimental/microfrontend/lib/cpu_features.h"
+#include "tensorflow/lite/experimental/microfrontend/lib/noise_reduction_dispatch.h"
+
+// The scalar kernel.
+static void Apply(struct NoiseReductionState* state, uint32_t* signal) {
   int i;
   for (i = 0; i < state->num_channels; ++i) {
-    const uint32_t smoothing =
-        ((i & 1) == 0) ? state->even_smoothing : state->odd_smoothing;
-    const uint32_t one_minus_smoothing = (1 << kNoiseReductionBits) - smoothing;
+    const uint32_t smoothing = state->smoothing[i];
+    const uint32_t one_minus_smoothing = state->one_minus_smoothing[i];
 
     // Update the estimate of the noise.
     const uint32_t signal_scaled_up = signal[i] << state->smoothing_bits;
@@ -46,6 +49,22 @@ void NoiseReductionApply(struct NoiseReductionState* state, uint32_t* signal) {
   }
 }
 
+static const struct NoiseReductionKernelSet kScalarKernels = {Apply};
+
+const struct NoiseReductionKernelSet* const kNoiseReductionScalarKernels =
+    &kScalarKernels;
+
+const struct NoiseReductionKernelSet* NoiseReductionKernelsForTier(int tier) {
+  return CPU_TIER_SELECT(tier, kNoiseReductionScalarKernels,
+                         kNoiseReductionSse41Kernels,
+                         kNoiseReductionAvx2Kernels,
+                         kNoiseReductionAvx512Kernels);
+}
+
+void NoiseReductionApply(struct NoiseReductionState* state, uint32_t* signal) {
+  NoiseReductionKernelsForTier(CpuActiveTier())->apply(state, signal);
+}
+
 void NoiseReductionReset(struct NoiseReductionState* state) {
   memset(state->estimate, 0, sizeof(*state->estimate) * state->num_channels);
 }
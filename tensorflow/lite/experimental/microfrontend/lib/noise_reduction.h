@@ -31,6 +31,10 @@ struct NoiseReductionState {
   uint16_t min_signal_remaining;
   int num_channels;
   uint32_t* estimate;
+  // The smoothing of each channel, alternating between even_smoothing and
+  // odd_smoothing, and (1 << kNoiseReductionBits) minus it.
+  uint32_t* smoothing;
+  uint32_t* one_minus_smoothing;
 };
 
 // Removes stationary noise from each channel of the signal using a low pass
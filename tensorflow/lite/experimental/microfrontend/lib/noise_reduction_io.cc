@@ -14,10 +14,26 @@ limitations under the License.
 ==============================================================================*/
 #include "tensorflow/lite/experimental/microfrontend/lib/noise_reduction_io.h"
 
+static void PrintArray(FILE* fp, const char* name, const uint32_t* values,
+                       int size) {
+  fprintf(fp, "static uint32_t noise_reduction_%s[] = {", name);
+  int i;
+  for (i = 0; i < size; ++i) {
+    fprintf(fp, "%u", values[i]);
+    if (i < size - 1) {
+      fprintf(fp, ", ");
+    }
+  }
+  fprintf(fp, "};\n");
+}
+
 void NoiseReductionWriteMemmapPreamble(
     FILE* fp, const struct NoiseReductionState* state) {
   fprintf(fp, "static uint32_t noise_reduction_estimate[%d];\n",
           state->num_channels);
+  PrintArray(fp, "smoothing", state->smoothing, state->num_channels);
+  PrintArray(fp, "one_minus_smoothing", state->one_minus_smoothing,
+             state->num_channels);
   fprintf(fp, "\n");
 }
 
@@ -31,4 +47,8 @@ void NoiseReductionWriteMemmap(FILE* fp,
   fprintf(fp, "%s->num_channels = %d;\n", variable, state->num_channels);
 
   fprintf(fp, "%s->estimate = noise_reduction_estimate;\n", variable);
+  fprintf(fp, "%s->smoothing = noise_reduction_smoothing;\n", variable);
+  fprintf(fp,
+          "%s->one_minus_smoothing = noise_reduction_one_minus_smoothing;\n",
+          variable);
 }
@@ -0,0 +1,244 @@
+/* Copyright 2026 The pymicro-features Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef TENSORFLOW_LITE_EXPERIMENTAL_MICROFRONTEND_LIB_NOISE_REDUCTION_KERNELS_H_
+#define TENSORFLOW_LITE_EXPERIMENTAL_MICROFRONTEND_LIB_NOISE_REDUCTION_KERNELS_H_
+
+// C++-only SIMD kernels of NoiseReductionApply(), one channel per 32-bit
+// lane. The scalar loop multiplies 32-bit values by 14-bit smoothing
+// factors into 64-bit products, so each block multiplies its even and odd
+// lanes separately (pmuludq) and narrows the shifted 64-bit sums back to
+// the low 32 bits of each lane, as the scalar casts do.
+//
+// The including translation unit defines one of NOISE_REDUCTION_USE_SSE41,
+// NOISE_REDUCTION_USE_AVX2 and NOISE_REDUCTION_USE_AVX512 and names its CPU
+// tier with NOISE_REDUCTION_TIER, as filterbank_kernels.h does.
+
+#include <stdint.h>
+#include <string.h>
+
+#include "tensorflow/lite/experimental/microfrontend/lib/noise_reduction.h"
+#include "tensorflow/lite/experimental/microfrontend/lib/noise_reduction_dispatch.h"
+
+#if defined(NOISE_REDUCTION_USE_AVX2) || defined(NOISE_REDUCTION_USE_AVX512)
+#include <immintrin.h>
+#else
+#include <smmintrin.h>
+#endif
+
+namespace noise_reduction {
+inline namespace NOISE_REDUCTION_TIER {
+
+// Each policy holds the lane operations of one instruction set. The shift
+// counts are in the low 64 bits of a __m128i, as psrld takes them.
+#if defined(NOISE_REDUCTION_USE_SSE41)
+struct Ops {
+  typedef __m128i V;
+  static const int kLanes = 4;
+
+  static inline V Load(const uint32_t* values) {
+    return _mm_loadu_si128(reinterpret_cast<const __m128i*>(values));
+  }
+  static inline void Store(uint32_t* values, V v) {
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(values), v);
+  }
+  // The first count lanes, for the channels past the last whole block.
+  static inline V LoadTail(const uint32_t* values, int count) {
+    uint32_t lanes[kLanes] = {0};
+    memcpy(lanes, values, count * sizeof(*values));
+    return Load(lanes);
+  }
+  static inline void StoreTail(uint32_t* values, V v, int count) {
+    uint32_t lanes[kLanes];
+    Store(lanes, v);
+    memcpy(values, lanes, count * sizeof(*values));
+  }
+  static inline V Set1(uint32_t value) { return _mm_set1_epi32(value); }
+  static inline V Min(V a, V b) { return _mm_min_epu32(a, b); }
+  static inline V Max(V a, V b) { return _mm_max_epu32(a, b); }
+  static inline V Sub(V a, V b) { return _mm_sub_epi32(a, b); }
+  static inline V ShiftLeft(V v, __m128i count) {
+    return _mm_sll_epi32(v, count);
+  }
+  static inline V ShiftRight(V v, __m128i count) {
+    return _mm_srl_epi32(v, count);
+  }
+  // The products of the even lanes, and of the odd ones.
+  static inline V MulEven(V a, V b) { return _mm_mul_epu32(a, b); }
+  static inline V MulOdd(V a, V b) {
+    return _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+  }
+  static inline V Add64(V a, V b) { return _mm_add_epi64(a, b); }
+  // Bits kNoiseReductionBits and up of the 64-bit sums, in the lanes they
+  // came from.
+  static inline V Narrow(V even, V odd) {
+    return _mm_blend_epi16(_mm_srli_epi64(even, kNoiseReductionBits),
+                           _mm_slli_epi64(odd, 32 - kNoiseReductionBits),
+                           0xCC);
+  }
+};
+#elif defined(NOISE_REDUCTION_USE_AVX2)
+struct Ops {
+  typedef __m256i V;
+  static const int kLanes = 8;
+
+  static inline V Load(const uint32_t* values) {
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values));
+  }
+  static inline void Store(uint32_t* values, V v) {
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(values), v);
+  }
+  static inline __m256i TailMask(int count) {
+    return _mm256_cmpgt_epi32(_mm256_set1_epi32(count),
+                              _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+  }
+  static inline V LoadTail(const uint32_t* values, int count) {
+    return _mm256_maskload_epi32(reinterpret_cast<const int*>(values),
+                                 TailMask(count));
+  }
+  static inline void StoreTail(uint32_t* values, V v, int count) {
+    _mm256_maskstore_epi32(reinterpret_cast<int*>(values), TailMask(count),
+                           v);
+  }
+  static inline V Set1(uint32_t value) { return _mm256_set1_epi32(value); }
+  static inline V Min(V a, V b) { return _mm256_min_epu32(a, b); }
+  static inline V Max(V a, V b) { return _mm256_max_epu32(a, b); }
+  static inline V Sub(V a, V b) { return _mm256_sub_epi32(a, b); }
+  static inline V ShiftLeft(V v, __m128i count) {
+    return _mm256_sll_epi32(v, count);
+  }
+  static inline V ShiftRight(V v, __m128i count) {
+    return _mm256_srl_epi32(v, count);
+  }
+  static inline V MulEven(V a, V b) { return _mm256_mul_epu32(a, b); }
+  static inline V MulOdd(V a, V b) {
+    return _mm256_mul_epu32(_mm256_srli_epi64(a, 32),
+                            _mm256_srli_epi64(b, 32));
+  }
+  static inline V Add64(V a, V b) { return _mm256_add_epi64(a, b); }
+  static inline V Narrow(V even, V odd) {
+    return _mm256_blend_epi32(_mm256_srli_epi64(even, kNoiseReductionBits),
+                              _mm256_slli_epi64(odd, 32 - kNoiseReductionBits),
+                              0xAA);
+  }
+};
+#elif defined(NOISE_REDUCTION_USE_AVX512)
+struct Ops {
+  typedef __m512i V;
+  static const int kLanes = 16;
+
+  static inline V Load(const uint32_t* values) {
+    return _mm512_loadu_si512(values);
+  }
+  static inline void Store(uint32_t* values, V v) {
+    _mm512_storeu_si512(values, v);
+  }
+  static inline V LoadTail(const uint32_t* values, int count) {
+    return _mm512_maskz_loadu_epi32((1u << count) - 1, values);
+  }
+  static inline void StoreTail(uint32_t* values, V v, int count) {
+    _mm512_mask_storeu_epi32(values, (1u << count) - 1, v);
+  }
+  static inline V Set1(uint32_t value) { return _mm512_set1_epi32(value); }
+  static inline V Min(V a, V b) { return _mm512_min_epu32(a, b); }
+  static inline V Max(V a, V b) { return _mm512_max_epu32(a, b); }
+  static inline V Sub(V a, V b) { return _mm512_sub_epi32(a, b); }
+  static inline V ShiftLeft(V v, __m128i count) {
+    return _mm512_sll_epi32(v, count);
+  }
+  static inline V ShiftRight(V v, __m128i count) {
+    return _mm512_srl_epi32(v, count);
+  }
+  static inline V MulEven(V a, V b) { return _mm512_mul_epu32(a, b); }
+  static inline V MulOdd(V a, V b) {
+    return _mm512_mul_epu32(_mm512_srli_epi64(a, 32),
+                            _mm512_srli_epi64(b, 32));
+  }
+  static inline V Add64(V a, V b) { return _mm512_add_epi64(a, b); }
+  static inline V Narrow(V even, V odd) {
+    return _mm512_mask_blend_epi32(
+        0xAAAA, _mm512_srli_epi64(even, kNoiseReductionBits),
+        _mm512_slli_epi64(odd, 32 - kNoiseReductionBits));
+  }
+};
+#endif
+
+// Loads and stores the values of a whole block, or of the first count
+// channels of the last one.
+template <bool kTail>
+inline Ops::V LoadBlock(const uint32_t* values, int count) {
+  return kTail ? Ops::LoadTail(values, count) : Ops::Load(values);
+}
+template <bool kTail>
+inline void StoreBlock(uint32_t* values, Ops::V v, int count) {
+  if (kTail) {
+    Ops::StoreTail(values, v, count);
+  } else {
+    Ops::Store(values, v);
+  }
+}
+
+// Same as the scalar NoiseReductionApply() on a block of Ops::kLanes
+// channels, or on the count channels left over.
+template <bool kTail>
+inline void ApplyBlock(struct NoiseReductionState* state, int first,
+                       int count, __m128i shift,
+                       Ops::V min_signal_remaining, uint32_t* signal) {
+  const Ops::V input = LoadBlock<kTail>(signal + first, count);
+  const Ops::V signal_scaled_up = Ops::ShiftLeft(input, shift);
+  const Ops::V smoothing = LoadBlock<kTail>(state->smoothing + first, count);
+  const Ops::V one_minus_smoothing =
+      LoadBlock<kTail>(state->one_minus_smoothing + first, count);
+  const Ops::V old_estimate = LoadBlock<kTail>(state->estimate + first, count);
+
+  // Update the estimate of the noise.
+  const Ops::V estimate = Ops::Narrow(
+      Ops::Add64(Ops::MulEven(signal_scaled_up, smoothing),
+                 Ops::MulEven(old_estimate, one_minus_smoothing)),
+      Ops::Add64(Ops::MulOdd(signal_scaled_up, smoothing),
+                 Ops::MulOdd(old_estimate, one_minus_smoothing)));
+  StoreBlock<kTail>(state->estimate + first, estimate, count);
+
+  const Ops::V floor =
+      Ops::Narrow(Ops::MulEven(input, min_signal_remaining),
+                  Ops::MulOdd(input, min_signal_remaining));
+  const Ops::V subtracted = Ops::ShiftRight(
+      Ops::Sub(signal_scaled_up, Ops::Min(estimate, signal_scaled_up)),
+      shift);
+  StoreBlock<kTail>(signal + first, Ops::Max(subtracted, floor), count);
+}
+
+// Same as the scalar NoiseReductionApply().
+void Apply(struct NoiseReductionState* state, uint32_t* signal) {
+  const int num_channels = state->num_channels;
+  const __m128i shift = _mm_cvtsi32_si128(state->smoothing_bits);
+  const Ops::V min_signal_remaining =
+      Ops::Set1(state->min_signal_remaining);
+  int i;
+  for (i = 0; i + Ops::kLanes <= num_channels; i += Ops::kLanes) {
+    ApplyBlock<false>(state, i, Ops::kLanes, shift, min_signal_remaining,
+                      signal);
+  }
+  if (i < num_channels) {
+    ApplyBlock<true>(state, i, num_channels - i, shift, min_signal_remaining,
+                     signal);
+  }
+}
+
+const struct NoiseReductionKernelSet kKernelSet = {Apply};
+
+}  // namespace NOISE_REDUCTION_TIER
+}  // namespace noise_reduction
+
+#endif  // TENSORFLOW_LITE_EXPERIMENTAL_MICROFRONTEND_LIB_NOISE_REDUCTION_KERNELS_H_
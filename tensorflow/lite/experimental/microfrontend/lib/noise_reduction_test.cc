@@ -14,6 +14,9 @@ limitations under the License.
 ==============================================================================*/
 #include "tensorflow/lite/experimental/microfrontend/lib/noise_reduction.h"
 
+#include <algorithm>
+
+#include "tensorflow/lite/experimental/microfrontend/lib/cpu_features.h"
 #include "tensorflow/lite/experimental/microfrontend/lib/noise_reduction_util.h"
 #include "tensorflow/lite/micro/testing/micro_test.h"
 
@@ -34,6 +37,110 @@ class NoiseReductionTestConfig {
   struct NoiseReductionConfig config_;
 };
 
+// The loop NoiseReductionApply() used to run, choosing the smoothing of
+// each channel from its parity.
+void ReferenceApply(const struct NoiseReductionState* state,
+                    uint32_t* estimates, uint32_t* signal) {
+  int i;
+  for (i = 0; i < state->num_channels; ++i) {
+    const uint32_t smoothing =
+        ((i & 1) == 0) ? state->even_smoothing : state->odd_smoothing;
+    const uint32_t one_minus_smoothing = (1 << kNoiseReductionBits) - smoothing;
+    const uint32_t signal_scaled_up = signal[i] << state->smoothing_bits;
+    uint32_t estimate = (((uint64_t)signal_scaled_up * smoothing) +
+                         ((uint64_t)estimates[i] * one_minus_smoothing)) >>
+                        kNoiseReductionBits;
+    estimates[i] = estimate;
+    if (estimate > signal_scaled_up) {
+      estimate = signal_scaled_up;
+    }
+    const uint32_t floor =
+        ((uint64_t)signal[i] * state->min_signal_remaining) >>
+        kNoiseReductionBits;
+    const uint32_t subtracted =
+        (signal_scaled_up - estimate) >> state->smoothing_bits;
+    signal[i] = subtracted > floor ? subtracted : floor;
+  }
+}
+
+uint32_t NextRandom(uint32_t* seed) {
+  *seed = *seed * 1664525u + 1013904223u;
+  return *seed;
+}
+
+// Runs num_frames frames of num_channels channels through every CPU tier
+// and the reference loop, and checks that the outputs and estimates match
+// after each frame. Speech-like frames have slowly varying per-channel
+// levels with bursts on top, in the range the filterbank produces; the
+// others are random 32-bit values at random scales, many of which overflow
+// when scaled up.
+void CheckMatchesReference(int smoothing_bits, int num_channels,
+                           int num_frames, bool speech_like) {
+  struct NoiseReductionConfig config;
+  NoiseReductionFillConfigWithDefaults(&config);
+  config.smoothing_bits = smoothing_bits;
+  struct NoiseReductionState state;
+  TF_LITE_MICRO_EXPECT(
+      NoiseReductionPopulateState(&config, &state, num_channels));
+
+  const int active_tier = CpuActiveTier();
+  const int num_tiers = CpuDetectTier() + 1;
+  uint32_t* estimates = new uint32_t[num_channels * (num_tiers + 1)];
+  uint32_t* signals = new uint32_t[num_channels * (num_tiers + 1)];
+  uint32_t* levels = new uint32_t[num_channels];
+  std::fill(estimates, estimates + num_channels * (num_tiers + 1), 0);
+  uint32_t seed = 17 + smoothing_bits;
+  int i;
+  for (i = 0; i < num_channels; ++i) {
+    levels[i] = 200 + NextRandom(&seed) % 2000;
+  }
+
+  int frame;
+  for (frame = 0; frame < num_frames; ++frame) {
+    uint32_t* expected = signals + num_channels * num_tiers;
+    for (i = 0; i < num_channels; ++i) {
+      if (speech_like) {
+        levels[i] += levels[i] / 64 * (NextRandom(&seed) % 3) - levels[i] / 64;
+        if (levels[i] < 100) {
+          levels[i] = 100;
+        }
+        const bool burst = (frame / 25) % 4 == 1;
+        expected[i] = levels[i] * (burst ? 20 + NextRandom(&seed) % 40 : 1) +
+                      NextRandom(&seed) % 64;
+      } else {
+        expected[i] = NextRandom(&seed) >> (NextRandom(&seed) % 32);
+      }
+    }
+    int tier;
+    for (tier = 0; tier < num_tiers; ++tier) {
+      std::copy(expected, expected + num_channels,
+                signals + num_channels * tier);
+    }
+    ReferenceApply(&state, estimates + num_channels * num_tiers, expected);
+
+    for (tier = 0; tier < num_tiers; ++tier) {
+      TF_LITE_MICRO_EXPECT(CpuSetTier(tier));
+      std::copy(estimates + num_channels * tier,
+                estimates + num_channels * (tier + 1), state.estimate);
+      NoiseReductionApply(&state, signals + num_channels * tier);
+      std::copy(state.estimate, state.estimate + num_channels,
+                estimates + num_channels * tier);
+      for (i = 0; i < num_channels; ++i) {
+        TF_LITE_MICRO_EXPECT_EQ(signals[num_channels * tier + i],
+                                expected[i]);
+        TF_LITE_MICRO_EXPECT_EQ(estimates[num_channels * tier + i],
+                                estimates[num_channels * num_tiers + i]);
+      }
+    }
+  }
+  CpuSetTier(active_tier);
+
+  delete[] levels;
+  delete[] signals;
+  delete[] estimates;
+  NoiseReductionFreeStateContents(&state);
+}
+
 }  // namespace
 
 TF_LITE_MICRO_TESTS_BEGIN
@@ -78,4 +185,32 @@ TF_LITE_MICRO_TEST(NoiseReductionTest_TestNoiseReduction) {
   NoiseReductionFreeStateContents(&state);
 }
 
+TF_LITE_MICRO_TEST(NoiseReductionTest_CheckSmoothing) {
+  NoiseReductionTestConfig config;
+  struct NoiseReductionState state;
+  TF_LITE_MICRO_EXPECT(NoiseReductionPopulateState(&config.config_, &state, 3));
+
+  const uint32_t expected_smoothing[] = {409, 983, 409};
+  int i;
+  for (i = 0; i < state.num_channels; ++i) {
+    TF_LITE_MICRO_EXPECT_EQ(state.smoothing[i], expected_smoothing[i]);
+    TF_LITE_MICRO_EXPECT_EQ(state.one_minus_smoothing[i],
+                            16384 - expected_smoothing[i]);
+  }
+
+  NoiseReductionFreeStateContents(&state);
+}
+
+TF_LITE_MICRO_TEST(NoiseReductionTest_MatchesReferenceOnRandomInput) {
+  // 37 channels leave a partial block on every tier.
+  CheckMatchesReference(10, 37, 3000, false);
+  CheckMatchesReference(0, 40, 1000, false);
+  CheckMatchesReference(5, 3, 1000, false);
+}
+
+TF_LITE_MICRO_TEST(NoiseReductionTest_MatchesReferenceOnSpeechLikeInput) {
+  CheckMatchesReference(10, 40, 5000, true);
+  CheckMatchesReference(10, 37, 5000, true);
+}
+
 TF_LITE_MICRO_TESTS_END
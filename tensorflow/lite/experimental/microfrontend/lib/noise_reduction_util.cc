@@ -33,13 +33,27 @@ int NoiseReductionPopulateState(const struct NoiseReductionConfig* config,
       config->min_signal_remaining * (1 << kNoiseReductionBits);
   state->num_channels = num_channels;
   state->estimate = (uint32_t*)calloc(state->num_channels, sizeof(*state->estimate));
-  if (state->estimate == NULL) {
-    fprintf(stderr, "Failed to alloc estimate buffer\n");
+  state->smoothing =
+      (uint32_t*)malloc(state->num_channels * sizeof(*state->smoothing));
+  state->one_minus_smoothing = (uint32_t*)malloc(
+      state->num_channels * sizeof(*state->one_minus_smoothing));
+  if (state->estimate == NULL || state->smoothing == NULL ||
+      state->one_minus_smoothing == NULL) {
+    fprintf(stderr, "Failed to alloc noise reduction buffers\n");
     return 0;
   }
+  int i;
+  for (i = 0; i < state->num_channels; ++i) {
+    state->smoothing[i] =
+        ((i & 1) == 0) ? state->even_smoothing : state->odd_smoothing;
+    state->one_minus_smoothing[i] =
+        (1 << kNoiseReductionBits) - state->smoothing[i];
+  }
   return 1;
 }
 
 void NoiseReductionFreeStateContents(struct NoiseReductionState* state) {
   free(state->estimate);
+  free(state->smoothing);
+  free(state->one_minus_smoothing);
 }
@@ -15,6 +15,8 @@ limitations under the License.
 #include "tensorflow/lite/experimental/microfrontend/lib/pcan_gain_control.h"
 
 #include "tensorflow/lite/experimental/microfrontend/lib/bits.h"
+#include "tensorflow/lite/experimental/microfrontend/lib/cpu_features.h"
+#include "tensorflow/lite/experimental/microfrontend/lib/pcan_gain_control_dispatch.h"
 
 int16_t WideDynamicFunction(const uint32_t x, const int16_t* lut) {
   if (x <= 2) {
@@ -44,8 +46,8 @@ uint32_t PcanShrink(const uint32_t x) {
   }
 }
 
-void PcanGainControlApply(struct PcanGainControlState* state,
-                          uint32_t* signal) {
+// The scalar kernel.
+static void Apply(struct PcanGainControlState* state, uint32_t* signal) {
   int i;
   for (i = 0; i < state->num_channels; ++i) {
     const uint32_t gain =
@@ -54,3 +56,21 @@ void PcanGainControlApply(struct PcanGainControlState* state,
     signal[i] = PcanShrink(snr);
   }
 }
+
+static const struct PcanGainControlKernelSet kScalarKernels = {Apply};
+
+const struct PcanGainControlKernelSet* const kPcanGainControlScalarKernels =
+    &kScalarKernels;
+
+const struct PcanGainControlKernelSet* PcanGainControlKernelsForTier(
+    int tier) {
+  return CPU_TIER_SELECT(tier, kPcanGainControlScalarKernels,
+                         kPcanGainControlSse41Kernels,
+                         kPcanGainControlAvx2Kernels,
+                         kPcanGainControlAvx512Kernels);
+}
+
+void PcanGainControlApply(struct PcanGainControlState* state,
+                          uint32_t* signal) {
+  PcanGainControlKernelsForTier(CpuActiveTier())->apply(state, signal);
+}
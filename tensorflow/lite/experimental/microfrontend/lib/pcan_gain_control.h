@@ -21,6 +21,9 @@ limitations under the License.
 #define kPcanSnrBits 12
 #define kPcanOutputBits 6
 
+// Intervals of the gain LUT, by the bit length of the noise estimate.
+#define kPcanNumIntervals 33
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -32,6 +35,11 @@ struct PcanGainControlState {
   int num_channels;
   int16_t* gain_lut;
   int32_t snr_shift;
+  // The gain_lut coefficients of each interval, the bit length of the noise
+  // estimate, widened to 32 bits for the SIMD kernels: kPcanNumIntervals
+  // gains at each interval's start, then as many first and second order
+  // terms. Intervals 0 and 1 hold the gains of 0 and 1, with zero terms.
+  int32_t* interval_coefficients;
 };
 
 int16_t WideDynamicFunction(const uint32_t x, const int16_t* lut);
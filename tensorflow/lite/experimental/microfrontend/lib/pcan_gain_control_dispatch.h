@@ -0,0 +1,53 @@
+/* Copyright 2026 The pymicro-features Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef TENSORFLOW_LITE_EXPERIMENTAL_MICROFRONTEND_LIB_PCAN_GAIN_CONTROL_DISPATCH_H_
+#define TENSORFLOW_LITE_EXPERIMENTAL_MICROFRONTEND_LIB_PCAN_GAIN_CONTROL_DISPATCH_H_
+
+#include <stdint.h>
+
+#include "tensorflow/lite/experimental/microfrontend/lib/cpu_features.h"
+#include "tensorflow/lite/experimental/microfrontend/lib/pcan_gain_control.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// The gain control kernels built for one CPU tier (see cpu_features.h).
+// pcan_gain_control.cc holds the scalar set, and pcan_gain_control_<tier>.cc
+// the others.
+struct PcanGainControlKernelSet {
+  // PcanGainControlApply().
+  void (*apply)(struct PcanGainControlState* state, uint32_t* signal);
+};
+
+extern const struct PcanGainControlKernelSet* const
+    kPcanGainControlScalarKernels;
+#ifdef CPU_FEATURES_X86
+extern const struct PcanGainControlKernelSet* const
+    kPcanGainControlSse41Kernels;
+extern const struct PcanGainControlKernelSet* const
+    kPcanGainControlAvx2Kernels;
+extern const struct PcanGainControlKernelSet* const
+    kPcanGainControlAvx512Kernels;
+#endif
+
+// Returns the kernels for the given tier.
+const struct PcanGainControlKernelSet* PcanGainControlKernelsForTier(int tier);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif  // TENSORFLOW_LITE_EXPERIMENTAL_MICROFRONTEND_LIB_PCAN_GAIN_CONTROL_DISPATCH_H_
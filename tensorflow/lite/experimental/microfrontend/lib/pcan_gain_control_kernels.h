@@ -0,0 +1,339 @@
+/* Copyright 2026 The pymicro-features Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef TENSORFLOW_LITE_EXPERIMENTAL_MICROFRONTEND_LIB_PCAN_GAIN_CONTROL_KERNELS_H_
+#define TENSORFLOW_LITE_EXPERIMENTAL_MICROFRONTEND_LIB_PCAN_GAIN_CONTROL_KERNELS_H_
+
+// C++-only SIMD kernels of PcanGainControlApply(), one channel per 32-bit
+// lane. WideDynamicFunction() needs the position of the most significant bit
+// of the noise estimate and the ten bits below it: both are read off the
+// exponent and mantissa of the estimate converted to float, which is exact
+// once estimates of 2^24 and up are shifted down by 8 bits. The interval
+// then looks its coefficients up in the rows of
+// PcanGainControlState::interval_coefficients, where intervals 0 and 1 need
+// no special case: with gathers, or on AVX-512 with a permute over the
+// first 32 entries, which is quicker. The interpolation and PcanShrink() run
+// on 32-bit lanes with the same wrapping as the scalar code. The gain times
+// the signal needs 64 bits, and is done on the even and odd lanes
+// separately (pmuludq).
+//
+// The including translation unit defines one of
+// PCAN_GAIN_CONTROL_USE_SSE41, PCAN_GAIN_CONTROL_USE_AVX2 and
+// PCAN_GAIN_CONTROL_USE_AVX512 and names its CPU tier with
+// PCAN_GAIN_CONTROL_TIER, as filterbank_kernels.h does.
+
+#include <stdint.h>
+#include <string.h>
+
+#include "tensorflow/lite/experimental/microfrontend/lib/pcan_gain_control.h"
+#include "tensorflow/lite/experimental/microfrontend/lib/pcan_gain_control_dispatch.h"
+
+#if defined(PCAN_GAIN_CONTROL_USE_AVX2) || \
+    defined(PCAN_GAIN_CONTROL_USE_AVX512)
+#include <immintrin.h>
+#else
+#include <smmintrin.h>
+#endif
+
+namespace pcan_gain_control {
+inline namespace PCAN_GAIN_CONTROL_TIER {
+
+// Each policy holds the lane operations of one instruction set. Masks are
+// whole lanes of ones, or mask registers on AVX-512.
+#if defined(PCAN_GAIN_CONTROL_USE_SSE41)
+struct Ops {
+  typedef __m128i V;
+  typedef __m128i Mask;
+  static const int kLanes = 4;
+
+  static inline V Load(const uint32_t* values) {
+    return _mm_loadu_si128(reinterpret_cast<const __m128i*>(values));
+  }
+  static inline void Store(uint32_t* values, V v) {
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(values), v);
+  }
+  // The first count lanes, for the channels past the last whole block.
+  static inline V LoadTail(const uint32_t* values, int count) {
+    uint32_t lanes[kLanes] = {0};
+    memcpy(lanes, values, count * sizeof(*values));
+    return Load(lanes);
+  }
+  static inline void StoreTail(uint32_t* values, V v, int count) {
+    uint32_t lanes[kLanes];
+    Store(lanes, v);
+    memcpy(values, lanes, count * sizeof(*values));
+  }
+
+  static inline V Set1(int32_t value) { return _mm_set1_epi32(value); }
+  static inline V Add(V a, V b) { return _mm_add_epi32(a, b); }
+  static inline V Sub(V a, V b) { return _mm_sub_epi32(a, b); }
+  static inline V MulLo(V a, V b) { return _mm_mullo_epi32(a, b); }
+  static inline V And(V a, V b) { return _mm_and_si128(a, b); }
+  static inline V Max(V a, V b) { return _mm_max_epi32(a, b); }
+  static inline V ShiftLeft(V v, int count) {
+    return _mm_slli_epi32(v, count);
+  }
+  static inline V ShiftRight(V v, int count) {
+    return _mm_srli_epi32(v, count);
+  }
+  static inline V ShiftRightArithmetic(V v, int count) {
+    return _mm_srai_epi32(v, count);
+  }
+  static inline Mask IsZero(V v) {
+    return _mm_cmpeq_epi32(v, _mm_setzero_si128());
+  }
+  static inline V Select(Mask mask, V if_true, V if_false) {
+    return _mm_blendv_epi8(if_false, if_true, mask);
+  }
+  // The bits of the lanes converted to float.
+  static inline V FloatBits(V v) {
+    return _mm_castps_si128(_mm_cvtepi32_ps(v));
+  }
+  // row[interval] in each lane, for intervals of 0 to 32. There is no
+  // gather or wide permute before AVX2.
+  typedef __m128i Index;
+  static inline Index MakeIndex(V interval) { return interval; }
+  static inline V Lookup(const int32_t* row, Index index) {
+    return _mm_setr_epi32(row[_mm_cvtsi128_si32(index)],
+                          row[_mm_extract_epi32(index, 1)],
+                          row[_mm_extract_epi32(index, 2)],
+                          row[_mm_extract_epi32(index, 3)]);
+  }
+  // Bits count and up of the products of the unsigned lanes, truncated to
+  // 32 bits, with the products in 64 bits.
+  static inline V MulShiftRight(V a, V b, __m128i count) {
+    const __m128i even = _mm_srl_epi64(_mm_mul_epu32(a, b), count);
+    const __m128i odd = _mm_srl_epi64(
+        _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32)), count);
+    return _mm_blend_epi16(even, _mm_slli_epi64(odd, 32), 0xCC);
+  }
+};
+#elif defined(PCAN_GAIN_CONTROL_USE_AVX2)
+struct Ops {
+  typedef __m256i V;
+  typedef __m256i Mask;
+  static const int kLanes = 8;
+
+  static inline V Load(const uint32_t* values) {
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values));
+  }
+  static inline void Store(uint32_t* values, V v) {
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(values), v);
+  }
+  static inline __m256i TailMask(int count) {
+    return _mm256_cmpgt_epi32(_mm256_set1_epi32(count),
+                              _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+  }
+  static inline V LoadTail(const uint32_t* values, int count) {
+    return _mm256_maskload_epi32(reinterpret_cast<const int*>(values),
+                                 TailMask(count));
+  }
+  static inline void StoreTail(uint32_t* values, V v, int count) {
+    _mm256_maskstore_epi32(reinterpret_cast<int*>(values), TailMask(count),
+                           v);
+  }
+
+  static inline V Set1(int32_t value) { return _mm256_set1_epi32(value); }
+  static inline V Add(V a, V b) { return _mm256_add_epi32(a, b); }
+  static inline V Sub(V a, V b) { return _mm256_sub_epi32(a, b); }
+  static inline V MulLo(V a, V b) { return _mm256_mullo_epi32(a, b); }
+  static inline V And(V a, V b) { return _mm256_and_si256(a, b); }
+  static inline V Max(V a, V b) { return _mm256_max_epi32(a, b); }
+  static inline V ShiftLeft(V v, int count) {
+    return _mm256_slli_epi32(v, count);
+  }
+  static inline V ShiftRight(V v, int count) {
+    return _mm256_srli_epi32(v, count);
+  }
+  static inline V ShiftRightArithmetic(V v, int count) {
+    return _mm256_srai_epi32(v, count);
+  }
+  static inline Mask IsZero(V v) {
+    return _mm256_cmpeq_epi32(v, _mm256_setzero_si256());
+  }
+  static inline V Select(Mask mask, V if_true, V if_false) {
+    return _mm256_blendv_epi8(if_false, if_true, mask);
+  }
+  static inline V FloatBits(V v) {
+    return _mm256_castps_si256(_mm256_cvtepi32_ps(v));
+  }
+  // Gathers measured quicker than picking from four eight-lane permutes.
+  typedef __m256i Index;
+  static inline Index MakeIndex(V interval) { return interval; }
+  static inline V Lookup(const int32_t* row, Index index) {
+    return _mm256_i32gather_epi32(reinterpret_cast<const int*>(row), index,
+                                  4);
+  }
+  static inline V MulShiftRight(V a, V b, __m128i count) {
+    const __m256i even = _mm256_srl_epi64(_mm256_mul_epu32(a, b), count);
+    const __m256i odd = _mm256_srl_epi64(
+        _mm256_mul_epu32(_mm256_srli_epi64(a, 32), _mm256_srli_epi64(b, 32)),
+        count);
+    return _mm256_blend_epi32(even, _mm256_slli_epi64(odd, 32), 0xAA);
+  }
+};
+#elif defined(PCAN_GAIN_CONTROL_USE_AVX512)
+struct Ops {
+  typedef __m512i V;
+  typedef __mmask16 Mask;
+  static const int kLanes = 16;
+
+  static inline V Load(const uint32_t* values) {
+    return _mm512_loadu_si512(values);
+  }
+  static inline void Store(uint32_t* values, V v) {
+    _mm512_storeu_si512(values, v);
+  }
+  static inline V LoadTail(const uint32_t* values, int count) {
+    return _mm512_maskz_loadu_epi32((1u << count) - 1, values);
+  }
+  static inline void StoreTail(uint32_t* values, V v, int count) {
+    _mm512_mask_storeu_epi32(values, (1u << count) - 1, v);
+  }
+
+  static inline V Set1(int32_t value) { return _mm512_set1_epi32(value); }
+  static inline V Add(V a, V b) { return _mm512_add_epi32(a, b); }
+  static inline V Sub(V a, V b) { return _mm512_sub_epi32(a, b); }
+  static inline V MulLo(V a, V b) { return _mm512_mullo_epi32(a, b); }
+  static inline V And(V a, V b) { return _mm512_and_si512(a, b); }
+  static inline V Max(V a, V b) { return _mm512_max_epi32(a, b); }
+  static inline V ShiftLeft(V v, int count) {
+    return _mm512_slli_epi32(v, count);
+  }
+  static inline V ShiftRight(V v, int count) {
+    return _mm512_srli_epi32(v, count);
+  }
+  static inline V ShiftRightArithmetic(V v, int count) {
+    return _mm512_srai_epi32(v, count);
+  }
+  static inline Mask IsZero(V v) { return _mm512_testn_epi32_mask(v, v); }
+  static inline V Select(Mask mask, V if_true, V if_false) {
+    return _mm512_mask_blend_epi32(mask, if_false, if_true);
+  }
+  static inline V FloatBits(V v) {
+    return _mm512_castps_si512(_mm512_cvtepi32_ps(v));
+  }
+  // One two-register permute covers intervals 0 to 31.
+  struct Index {
+    __m512i interval;
+    __mmask16 top;
+  };
+  static inline Index MakeIndex(V interval) {
+    Index index;
+    index.interval = interval;
+    index.top = _mm512_cmpeq_epi32_mask(interval, _mm512_set1_epi32(32));
+    return index;
+  }
+  static inline V Lookup(const int32_t* row, const Index& index) {
+    return _mm512_mask_blend_epi32(
+        index.top,
+        _mm512_permutex2var_epi32(_mm512_loadu_si512(row), index.interval,
+                                  _mm512_loadu_si512(row + 16)),
+        _mm512_set1_epi32(row[32]));
+  }
+  static inline V MulShiftRight(V a, V b, __m128i count) {
+    const __m512i even = _mm512_srl_epi64(_mm512_mul_epu32(a, b), count);
+    const __m512i odd = _mm512_srl_epi64(
+        _mm512_mul_epu32(_mm512_srli_epi64(a, 32), _mm512_srli_epi64(b, 32)),
+        count);
+    return _mm512_mask_blend_epi32(0xAAAA, even, _mm512_slli_epi64(odd, 32));
+  }
+};
+#endif
+
+// Loads and stores the values of a whole block, or of the first count
+// channels of the last one.
+template <bool kTail>
+inline Ops::V LoadBlock(const uint32_t* values, int count) {
+  return kTail ? Ops::LoadTail(values, count) : Ops::Load(values);
+}
+template <bool kTail>
+inline void StoreBlock(uint32_t* values, Ops::V v, int count) {
+  if (kTail) {
+    Ops::StoreTail(values, v, count);
+  } else {
+    Ops::Store(values, v);
+  }
+}
+
+// WideDynamicFunction() of each lane, sign-extended from 16 bits.
+inline Ops::V WideDynamicFunction(const int32_t* coefficients, Ops::V x) {
+  const Ops::Mask small = Ops::IsZero(Ops::ShiftRight(x, 24));
+  const Ops::V bits =
+      Ops::FloatBits(Ops::Select(small, x, Ops::ShiftRight(x, 8)));
+  // A biased exponent of 127 is interval 1. Zero converts to all zero bits,
+  // and is clamped to interval 0.
+  const Ops::V interval = Ops::Max(
+      Ops::Add(Ops::Sub(Ops::ShiftRight(bits, 23), Ops::Set1(126)),
+               Ops::Select(small, Ops::Set1(0), Ops::Set1(8))),
+      Ops::Set1(0));
+  const Ops::V frac = Ops::And(Ops::ShiftRight(bits, 13), Ops::Set1(0x3FF));
+
+  const Ops::Index index = Ops::MakeIndex(interval);
+  const Ops::V y0 = Ops::Lookup(coefficients, index);
+  const Ops::V a1 = Ops::Lookup(coefficients + kPcanNumIntervals, index);
+  const Ops::V a2 = Ops::Lookup(coefficients + 2 * kPcanNumIntervals, index);
+
+  Ops::V result = Ops::ShiftRightArithmetic(Ops::MulLo(a2, frac), 5);
+  result = Ops::Add(result, Ops::ShiftLeft(a1, 5));
+  result = Ops::MulLo(result, frac);
+  result = Ops::ShiftRightArithmetic(Ops::Add(result, Ops::Set1(1 << 14)), 15);
+  result = Ops::Add(result, y0);
+  return Ops::ShiftRightArithmetic(Ops::ShiftLeft(result, 16), 16);
+}
+
+// PcanShrink() of each lane.
+inline Ops::V Shrink(Ops::V x) {
+  const Ops::V small = Ops::ShiftRight(
+      Ops::MulLo(x, x), 2 + 2 * kPcanSnrBits - kPcanOutputBits);
+  const Ops::V large =
+      Ops::Sub(Ops::ShiftRight(x, kPcanSnrBits - kPcanOutputBits),
+               Ops::Set1(1 << kPcanOutputBits));
+  return Ops::Select(Ops::IsZero(Ops::ShiftRight(x, kPcanSnrBits + 1)),
+                     small, large);
+}
+
+// Same as the scalar PcanGainControlApply() on a block of Ops::kLanes
+// channels, or on the count channels left over.
+template <bool kTail>
+inline void ApplyBlock(const struct PcanGainControlState* state, int first,
+                       int count, __m128i snr_shift, uint32_t* signal) {
+  const Ops::V gain =
+      WideDynamicFunction(state->interval_coefficients,
+                          LoadBlock<kTail>(state->noise_estimate + first,
+                                           count));
+  const Ops::V snr = Ops::MulShiftRight(
+      LoadBlock<kTail>(signal + first, count), gain, snr_shift);
+  StoreBlock<kTail>(signal + first, Shrink(snr), count);
+}
+
+// Same as the scalar PcanGainControlApply().
+void Apply(struct PcanGainControlState* state, uint32_t* signal) {
+  const int num_channels = state->num_channels;
+  const __m128i snr_shift = _mm_cvtsi32_si128(state->snr_shift);
+  int i;
+  for (i = 0; i + Ops::kLanes <= num_channels; i += Ops::kLanes) {
+    ApplyBlock<false>(state, i, Ops::kLanes, snr_shift, signal);
+  }
+  if (i < num_channels) {
+    ApplyBlock<true>(state, i, num_channels - i, snr_shift, signal);
+  }
+}
+
+const struct PcanGainControlKernelSet kKernelSet = {Apply};
+
+}  // namespace PCAN_GAIN_CONTROL_TIER
+}  // namespace pcan_gain_control
+
+#endif  // TENSORFLOW_LITE_EXPERIMENTAL_MICROFRONTEND_LIB_PCAN_GAIN_CONTROL_KERNELS_H_
@@ -14,6 +14,9 @@ limitations under the License.
 ==============================================================================*/
 #include "tensorflow/lite/experimental/microfrontend/lib/pcan_gain_control.h"
 
+#include <algorithm>
+
+#include "tensorflow/lite/experimental/microfrontend/lib/cpu_features.h"
 #include "tensorflow/lite/experimental/microfrontend/lib/pcan_gain_control_util.h"
 #include "tensorflow/lite/micro/testing/micro_test.h"
 
@@ -36,6 +39,73 @@ class PcanGainControlTestConfig {
   struct PcanGainControlConfig config_;
 };
 
+uint32_t NextRandom(uint32_t* seed) {
+  *seed = *seed * 1664525u + 1013904223u;
+  return *seed;
+}
+
+// Checks every CPU tier against the scalar loop for num_frames frames of
+// num_channels channels. The noise estimates cover every interval of the
+// gain LUT, with the values around each power of two and around 2^24, where
+// the kernels change how they find the interval.
+void CheckMatchesScalar(const struct PcanGainControlConfig* config,
+                        int smoothing_bits, int correction_bits,
+                        int num_channels, int num_frames) {
+  uint32_t* estimate = new uint32_t[num_channels];
+  struct PcanGainControlState state;
+  TF_LITE_MICRO_EXPECT(PcanGainControlPopulateState(
+      config, &state, estimate, num_channels, smoothing_bits,
+      correction_bits));
+
+  const int active_tier = CpuActiveTier();
+  uint32_t* input = new uint32_t[num_channels];
+  uint32_t* expected = new uint32_t[num_channels];
+  uint32_t* signal = new uint32_t[num_channels];
+  uint32_t seed = 23 + correction_bits;
+  int frame;
+  for (frame = 0; frame < num_frames; ++frame) {
+    int i;
+    for (i = 0; i < num_channels; ++i) {
+      const uint32_t value = NextRandom(&seed);
+      const int bit = NextRandom(&seed) % 32;
+      switch (frame % 3) {
+        case 0:
+          estimate[i] = value >> bit;
+          break;
+        case 1:
+          estimate[i] = (1u << bit) + (value % 3) - 1;
+          break;
+        default:
+          estimate[i] = (1u << 24) + (value % 512) - 256;
+          break;
+      }
+      input[i] = NextRandom(&seed) >> (NextRandom(&seed) % 32);
+    }
+    estimate[0] = frame % 4;
+    estimate[num_channels - 1] = 0xFFFFFFFF - frame % 4;
+
+    TF_LITE_MICRO_EXPECT(CpuSetTier(kCpuTierScalar));
+    std::copy(input, input + num_channels, expected);
+    PcanGainControlApply(&state, expected);
+    int tier;
+    for (tier = kCpuTierScalar + 1; tier <= CpuDetectTier(); ++tier) {
+      TF_LITE_MICRO_EXPECT(CpuSetTier(tier));
+      std::copy(input, input + num_channels, signal);
+      PcanGainControlApply(&state, signal);
+      for (i = 0; i < num_channels; ++i) {
+        TF_LITE_MICRO_EXPECT_EQ(signal[i], expected[i]);
+      }
+    }
+  }
+  CpuSetTier(active_tier);
+
+  delete[] signal;
+  delete[] expected;
+  delete[] input;
+  PcanGainControlFreeStateContents(&state);
+  delete[] estimate;
+}
+
 }  // namespace
 
 TF_LITE_MICRO_TESTS_BEGIN
@@ -62,4 +132,47 @@ TF_LITE_MICRO_TEST(PcanGainControlTest_TestPcanGainControl) {
   PcanGainControlFreeStateContents(&state);
 }
 
+TF_LITE_MICRO_TEST(PcanGainControlTest_CheckIntervalCoefficients) {
+  uint32_t estimate[kNumChannels];
+  PcanGainControlTestConfig config;
+  struct PcanGainControlState state;
+  TF_LITE_MICRO_EXPECT(PcanGainControlPopulateState(
+      &config.config_, &state, estimate, kNumChannels, kSmoothingBits,
+      kCorrectionBits));
+
+  const int32_t* coefficients = state.interval_coefficients;
+  TF_LITE_MICRO_EXPECT_EQ(coefficients[0], state.gain_lut[0]);
+  TF_LITE_MICRO_EXPECT_EQ(coefficients[1], state.gain_lut[1]);
+  int interval;
+  for (interval = 0; interval < 2; ++interval) {
+    TF_LITE_MICRO_EXPECT_EQ(coefficients[kPcanNumIntervals + interval], 0);
+    TF_LITE_MICRO_EXPECT_EQ(coefficients[2 * kPcanNumIntervals + interval],
+                            0);
+  }
+  for (interval = 2; interval < kPcanNumIntervals; ++interval) {
+    int k;
+    for (k = 0; k < 3; ++k) {
+      TF_LITE_MICRO_EXPECT_EQ(coefficients[k * kPcanNumIntervals + interval],
+                              state.gain_lut[4 * interval - 6 + k]);
+    }
+  }
+
+  PcanGainControlFreeStateContents(&state);
+}
+
+TF_LITE_MICRO_TEST(PcanGainControlTest_SimdKernelsMatchScalar) {
+  PcanGainControlTestConfig config;
+  // 37 channels leave a partial block on every tier.
+  CheckMatchesScalar(&config.config_, kSmoothingBits, kCorrectionBits, 37,
+                     3000);
+  CheckMatchesScalar(&config.config_, kSmoothingBits, 3, 40, 1000);
+  config.config_.strength = 0.5;
+  config.config_.offset = 1.0;
+  config.config_.gain_bits = 16;
+  CheckMatchesScalar(&config.config_, 0, 0, 3, 1000);
+  config.config_.strength = 0.0;
+  CheckMatchesScalar(&config.config_, kSmoothingBits, kCorrectionBits, 80,
+                     500);
+}
+
 TF_LITE_MICRO_TESTS_END
@@ -84,9 +84,26 @@ int PcanGainControlPopulateState(const struct PcanGainControlConfig* config,
     state->gain_lut[4 * interval + 2] = (int16_t)a2;
   }
   state->gain_lut += 6;
+
+  state->interval_coefficients = (int32_t*)calloc(
+      3 * kPcanNumIntervals, sizeof(*state->interval_coefficients));
+  if (state->interval_coefficients == NULL) {
+    fprintf(stderr, "Failed to allocate gain interval coefficients\n");
+    return 0;
+  }
+  state->interval_coefficients[0] = state->gain_lut[0];
+  state->interval_coefficients[1] = state->gain_lut[1];
+  for (interval = 2; interval < kPcanNumIntervals; ++interval) {
+    const int16_t* lut = state->gain_lut + 4 * interval - 6;
+    int k;
+    for (k = 0; k < 3; ++k) {
+      state->interval_coefficients[k * kPcanNumIntervals + interval] = lut[k];
+    }
+  }
   return 1;
 }
 
 void PcanGainControlFreeStateContents(struct PcanGainControlState* state) {
   free(state->gain_lut);
+  free(state->interval_coefficients);
 }
@@ -16,10 +16,11 @@ limitations under the License.
 
 #include <string.h>
 
-int WindowProcessSamples(struct WindowState* state, const int16_t* samples,
-                         size_t num_samples, size_t* num_samples_read) {
-  const int size = state->size;
+#include "tensorflow/lite/experimental/microfrontend/lib/cpu_features.h"
+#include "tensorflow/lite/experimental/microfrontend/lib/window_dispatch.h"
 
+int WindowBufferSamples(struct WindowState* state, const int16_t* samples,
+                        size_t num_samples, size_t* num_samples_read) {
   // Copy samples from the samples buffer over to our local input.
   size_t max_samples_to_copy = state->size - state->input_used;
   if (max_samples_to_copy > num_samples) {
@@ -30,15 +31,21 @@ int WindowProcessSamples(struct WindowState* state, const int16_t* samples,
   *num_samples_read = max_samples_to_copy;
   state->input_used += max_samples_to_copy;
 
-  if (state->input_used < state->size) {
-    // We don't have enough samples to compute a window.
-    return 0;
-  }
+  // Report whether we have enough samples to compute a window.
+  return state->input_used >= state->size;
+}
 
-  // Apply the window to the input.
+void WindowAdvance(struct WindowState* state) {
+  // Shuffle the input down by the step size, and update how much we have used.
+  memmove(state->input, state->input + state->step,
+          sizeof(*state->input) * (state->size - state->step));
+  state->input_used -= state->step;
+}
+
+static int16_t Apply(const struct WindowState* state, const int16_t* input,
+                     int16_t* output) {
+  const int size = state->size;
   const int16_t* coefficients = state->coefficients;
-  const int16_t* input = state->input;
-  int16_t* output = state->output;
   int i;
   int16_t max_abs_output_value = 0;
   for (i = 0; i < size; ++i) {
@@ -52,10 +59,34 @@ int WindowProcessSamples(struct WindowState* state, const int16_t* samples,
       max_abs_output_value = new_value;
     }
   }
-  // Shuffle the input down by the step size, and update how much we have used.
-  memmove(state->input, state->input + state->step,
-          sizeof(*state->input) * (state->size - state->step));
-  state->input_used -= state->step;
+  return max_abs_output_value;
+}
+
+static const struct WindowKernelSet kScalarKernels = {Apply};
+
+const struct WindowKernelSet* const kWindowScalarKernels = &kScalarKernels;
+
+const struct WindowKernelSet* WindowKernelsForTier(int tier) {
+  return CPU_TIER_SELECT(tier, kWindowScalarKernels, kWindowSse41Kernels,
+                         kWindowAvx2Kernels, kWindowAvx512Kernels);
+}
+
+int16_t WindowApply(const struct WindowState* state, const int16_t* input,
+                    int16_t* output) {
+  return WindowKernelsForTier(CpuActiveTier())->apply(state, input, output);
+}
+
+int WindowProcessSamples(struct WindowState* state, const int16_t* samples,
+                         size_t num_samples, size_t* num_samples_read) {
+  if (!WindowBufferSamples(state, samples, num_samples, num_samples_read)) {
+    // We don't have enough samples to compute a window.
+    return 0;
+  }
+
+  // Apply the window to the input.
+  const int16_t max_abs_output_value =
+      WindowApply(state, state->input, state->output);
+  WindowAdvance(state);
   state->max_abs_output_value = max_abs_output_value;
 
   // Indicate that the output buffer is valid for the next stage.
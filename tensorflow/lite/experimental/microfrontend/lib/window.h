@@ -40,6 +40,20 @@ struct WindowState {
 int WindowProcessSamples(struct WindowState* state, const int16_t* samples,
                          size_t num_samples, size_t* num_samples_read);
 
+// The two halves of WindowProcessSamples() for callers that apply their own
+// window: WindowBufferSamples() copies samples into state->input and returns
+// non-zero once a full frame is buffered there, and WindowAdvance() then steps
+// the buffered input forward.
+int WindowBufferSamples(struct WindowState* state, const int16_t* samples,
+                        size_t num_samples, size_t* num_samples_read);
+void WindowAdvance(struct WindowState* state);
+
+// Applies the window to state->size samples at input, writes them to output
+// and returns the largest absolute value written. Does not touch the state,
+// so frames known up front can be windowed in any order.
+int16_t WindowApply(const struct WindowState* state, const int16_t* input,
+                    int16_t* output);
+
 void WindowReset(struct WindowState* state);
 
 #ifdef __cplusplus
@@ -0,0 +1,165 @@
+/* Copyright 2026 The pymicro-features Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef TENSORFLOW_LITE_EXPERIMENTAL_MICROFRONTEND_LIB_WINDOW_KERNELS_H_
+#define TENSORFLOW_LITE_EXPERIMENTAL_MICROFRONTEND_LIB_WINDOW_KERNELS_H_
+
+// C++-only SIMD kernels of WindowApply(), one sample per 16-bit lane. The
+// 32-bit product of a sample and its coefficient is split into its low and
+// high halves (pmullw, pmulhw), and bits kFrontendWindowBits to
+// kFrontendWindowBits + 15 of it are put back together, which is the int16_t
+// the scalar shift and cast keep. The largest absolute value is taken with
+// pabsw and a signed max, so an output of -32768, whose absolute value wraps
+// around to itself, is left out as it is by the scalar loop.
+//
+// The including translation unit defines one of WINDOW_USE_SSE41,
+// WINDOW_USE_AVX2 and WINDOW_USE_AVX512 and names its CPU tier with
+// WINDOW_TIER, as noise_reduction_kernels.h does.
+
+#include <stdint.h>
+
+#include "tensorflow/lite/experimental/microfrontend/lib/window.h"
+#include "tensorflow/lite/experimental/microfrontend/lib/window_dispatch.h"
+
+#if defined(WINDOW_USE_AVX2) || defined(WINDOW_USE_AVX512)
+#include <immintrin.h>
+#else
+#include <smmintrin.h>
+#endif
+
+namespace window {
+inline namespace WINDOW_TIER {
+
+// Each policy holds the lane operations of one instruction set.
+#if defined(WINDOW_USE_SSE41)
+struct Ops {
+  typedef __m128i V;
+  static const int kLanes = 8;
+
+  static inline V Load(const int16_t* values) {
+    return _mm_loadu_si128(reinterpret_cast<const __m128i*>(values));
+  }
+  static inline void Store(int16_t* values, V v) {
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(values), v);
+  }
+  static inline V Zero() { return _mm_setzero_si128(); }
+  static inline V MulLow(V a, V b) { return _mm_mullo_epi16(a, b); }
+  static inline V MulHigh(V a, V b) { return _mm_mulhi_epi16(a, b); }
+  static inline V ShiftRight(V v) {
+    return _mm_srli_epi16(v, kFrontendWindowBits);
+  }
+  static inline V ShiftLeft(V v) {
+    return _mm_slli_epi16(v, 16 - kFrontendWindowBits);
+  }
+  static inline V Or(V a, V b) { return _mm_or_si128(a, b); }
+  static inline V Abs(V v) { return _mm_abs_epi16(v); }
+  static inline V Max(V a, V b) { return _mm_max_epi16(a, b); }
+};
+#elif defined(WINDOW_USE_AVX2)
+struct Ops {
+  typedef __m256i V;
+  static const int kLanes = 16;
+
+  static inline V Load(const int16_t* values) {
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values));
+  }
+  static inline void Store(int16_t* values, V v) {
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(values), v);
+  }
+  static inline V Zero() { return _mm256_setzero_si256(); }
+  static inline V MulLow(V a, V b) { return _mm256_mullo_epi16(a, b); }
+  static inline V MulHigh(V a, V b) { return _mm256_mulhi_epi16(a, b); }
+  static inline V ShiftRight(V v) {
+    return _mm256_srli_epi16(v, kFrontendWindowBits);
+  }
+  static inline V ShiftLeft(V v) {
+    return _mm256_slli_epi16(v, 16 - kFrontendWindowBits);
+  }
+  static inline V Or(V a, V b) { return _mm256_or_si256(a, b); }
+  static inline V Abs(V v) { return _mm256_abs_epi16(v); }
+  static inline V Max(V a, V b) { return _mm256_max_epi16(a, b); }
+};
+#elif defined(WINDOW_USE_AVX512)
+struct Ops {
+  typedef __m512i V;
+  static const int kLanes = 32;
+
+  static inline V Load(const int16_t* values) {
+    return _mm512_loadu_si512(values);
+  }
+  static inline void Store(int16_t* values, V v) {
+    _mm512_storeu_si512(values, v);
+  }
+  static inline V Zero() { return _mm512_setzero_si512(); }
+  static inline V MulLow(V a, V b) { return _mm512_mullo_epi16(a, b); }
+  static inline V MulHigh(V a, V b) { return _mm512_mulhi_epi16(a, b); }
+  static inline V ShiftRight(V v) {
+    return _mm512_srli_epi16(v, kFrontendWindowBits);
+  }
+  static inline V ShiftLeft(V v) {
+    return _mm512_slli_epi16(v, 16 - kFrontendWindowBits);
+  }
+  static inline V Or(V a, V b) { return _mm512_or_si512(a, b); }
+  static inline V Abs(V v) { return _mm512_abs_epi16(v); }
+  static inline V Max(V a, V b) { return _mm512_max_epi16(a, b); }
+};
+#endif
+
+// Same as the scalar WindowApply(). The samples past the last whole block
+// go through the scalar loop.
+int16_t Apply(const struct WindowState* state, const int16_t* input,
+              int16_t* output) {
+  const int size = state->size;
+  const int16_t* coefficients = state->coefficients;
+  Ops::V max_abs = Ops::Zero();
+  int i;
+  for (i = 0; i + Ops::kLanes <= size; i += Ops::kLanes) {
+    const Ops::V samples = Ops::Load(input + i);
+    const Ops::V weights = Ops::Load(coefficients + i);
+    const Ops::V windowed =
+        Ops::Or(Ops::ShiftRight(Ops::MulLow(samples, weights)),
+                Ops::ShiftLeft(Ops::MulHigh(samples, weights)));
+    Ops::Store(output + i, windowed);
+    max_abs = Ops::Max(max_abs, Ops::Abs(windowed));
+  }
+
+  int16_t lanes[Ops::kLanes];
+  Ops::Store(lanes, max_abs);
+  int16_t max_abs_output_value = 0;
+  int j;
+  for (j = 0; j < Ops::kLanes; ++j) {
+    if (lanes[j] > max_abs_output_value) {
+      max_abs_output_value = lanes[j];
+    }
+  }
+  for (; i < size; ++i) {
+    int16_t new_value =
+        (((int32_t)input[i]) * coefficients[i]) >> kFrontendWindowBits;
+    output[i] = new_value;
+    if (new_value < 0) {
+      new_value = -new_value;
+    }
+    if (new_value > max_abs_output_value) {
+      max_abs_output_value = new_value;
+    }
+  }
+  return max_abs_output_value;
+}
+
+const struct WindowKernelSet kKernelSet = {Apply};
+
+}  // namespace WINDOW_TIER
+}  // namespace window
+
+#endif  // TENSORFLOW_LITE_EXPERIMENTAL_MICROFRONTEND_LIB_WINDOW_KERNELS_H_
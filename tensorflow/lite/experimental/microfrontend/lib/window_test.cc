@@ -14,6 +14,7 @@ limitations under the License.
 ==============================================================================*/
 #include "tensorflow/lite/experimental/microfrontend/lib/window.h"
 
+#include "tensorflow/lite/experimental/microfrontend/lib/cpu_features.h"
 #include "tensorflow/lite/experimental/microfrontend/lib/window_util.h"
 #include "tensorflow/lite/micro/testing/micro_test.h"
 
@@ -38,6 +39,79 @@ class WindowTestConfig {
   struct WindowConfig config_;
 };
 
+// The loop WindowApply() runs on the scalar tier.
+int16_t ReferenceApply(const struct WindowState* state, const int16_t* input,
+                       int16_t* output) {
+  int16_t max_abs_output_value = 0;
+  size_t i;
+  for (i = 0; i < state->size; ++i) {
+    int16_t new_value =
+        (((int32_t)input[i]) * state->coefficients[i]) >> kFrontendWindowBits;
+    output[i] = new_value;
+    if (new_value < 0) {
+      new_value = -new_value;
+    }
+    if (new_value > max_abs_output_value) {
+      max_abs_output_value = new_value;
+    }
+  }
+  return max_abs_output_value;
+}
+
+uint32_t NextRandom(uint32_t* seed) {
+  *seed = *seed * 1664525u + 1013904223u;
+  return *seed;
+}
+
+// Windows num_frames random frames of size samples on every CPU tier and
+// checks the outputs and largest absolute values against the reference loop.
+// Most coefficients are in the 0 to 4096 range WindowPopulateState() gives,
+// the rest are any int16_t. Some samples are full scale, so that outputs of
+// -32768, whose absolute value the scalar loop leaves out, come up.
+void CheckMatchesReference(int size, int num_frames) {
+  struct WindowState state;
+  state.size = size;
+  state.coefficients = new int16_t[size];
+  int16_t* input = new int16_t[size];
+  int16_t* expected = new int16_t[size];
+  int16_t* output = new int16_t[size];
+
+  const int active_tier = CpuActiveTier();
+  const int num_tiers = CpuDetectTier() + 1;
+  uint32_t seed = 29 + size;
+  int frame;
+  for (frame = 0; frame < num_frames; ++frame) {
+    int i;
+    for (i = 0; i < size; ++i) {
+      const uint32_t kind = NextRandom(&seed) % 8;
+      const uint32_t coefficient = NextRandom(&seed);
+      state.coefficients[i] =
+          kind == 0 ? (int16_t)(coefficient >> 16)
+                    : (int16_t)(coefficient % ((1 << kFrontendWindowBits) + 1));
+      input[i] = kind == 1   ? -32768
+                 : kind == 2 ? 32767
+                             : (int16_t)(NextRandom(&seed) >> 16);
+    }
+    const int16_t expected_max = ReferenceApply(&state, input, expected);
+
+    int tier;
+    for (tier = 0; tier < num_tiers; ++tier) {
+      TF_LITE_MICRO_EXPECT(CpuSetTier(tier));
+      TF_LITE_MICRO_EXPECT_EQ(WindowApply(&state, input, output),
+                              expected_max);
+      for (i = 0; i < size; ++i) {
+        TF_LITE_MICRO_EXPECT_EQ(output[i], expected[i]);
+      }
+    }
+  }
+  CpuSetTier(active_tier);
+
+  delete[] output;
+  delete[] expected;
+  delete[] input;
+  delete[] state.coefficients;
+}
+
 }  // namespace
 
 TF_LITE_MICRO_TESTS_BEGIN
@@ -171,4 +245,43 @@ TF_LITE_MICRO_TEST(WindowState_CheckNotEnoughSamples) {
   WindowFreeStateContents(&state);
 }
 
+TF_LITE_MICRO_TEST(WindowState_ApplyMatchesReferenceOnRandomInput) {
+  // 400 and 480 samples are 25 ms and 30 ms at 16 kHz; the odd sizes leave a
+  // partial block on every tier.
+  CheckMatchesReference(400, 500);
+  CheckMatchesReference(480, 500);
+  CheckMatchesReference(kWindowSamples, 2000);
+  CheckMatchesReference(71, 2000);
+  CheckMatchesReference(1, 100);
+}
+
+TF_LITE_MICRO_TEST(WindowState_ApplyKeepsFullScaleOutputOutOfMax) {
+  // -32768 * 4096 windows to -32768, whose absolute value does not fit; the
+  // largest absolute value is then taken from the other samples on every
+  // tier.
+  const int kSize = 67;
+  int16_t coefficients[kSize];
+  int16_t input[kSize];
+  int16_t output[kSize];
+  int i;
+  for (i = 0; i < kSize; ++i) {
+    coefficients[i] = 1 << kFrontendWindowBits;
+    input[i] = (i % 3 == 0) ? -32768 : (int16_t)(i * 10);
+  }
+  struct WindowState state;
+  state.size = kSize;
+  state.coefficients = coefficients;
+
+  const int active_tier = CpuActiveTier();
+  int tier;
+  for (tier = 0; tier <= CpuDetectTier(); ++tier) {
+    TF_LITE_MICRO_EXPECT(CpuSetTier(tier));
+    TF_LITE_MICRO_EXPECT_EQ(WindowApply(&state, input, output), 650);
+    for (i = 0; i < kSize; ++i) {
+      TF_LITE_MICRO_EXPECT_EQ(output[i], input[i]);
+    }
+  }
+  CpuSetTier(active_tier);
+}
+
 TF_LITE_MICRO_TESTS_END
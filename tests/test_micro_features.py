@@ -1,7 +1,9 @@
 import statistics
 import wave
+from array import array
 from pathlib import Path
 
+import pytest
 from syrupy import SnapshotAssertion
 
 from pymicro_features import MicroFrontend
@@ -44,6 +46,99 @@ def test_zeros() -> None:
     assert len(output.features) == 40
 
 
+def test_features_buffer() -> None:
+    frontend = MicroFrontend()
+    audio = read_wav("speech.wav")
+
+    features = []
+    for i in range(0, 10 * BYTES_PER_CHUNK, BYTES_PER_CHUNK):
+        output = frontend.process_samples(audio[i : i + BYTES_PER_CHUNK])
+        features.append(output.features)
+
+    # Compact float32 buffers, not lists of separate floats
+    assert all(isinstance(f, array) and f.typecode == "f" for f in features)
+    assert [len(f) for f in features] == [0, 0] + [40] * 8
+
+    view = memoryview(features[-1])
+    assert view.format == "f"
+    assert view.nbytes == 40 * 4
+
+
+def test_process_audio() -> None:
+    frontend = MicroFrontend()
+    audio = read_wav("speech.wav")
+
+    expected = []
+    i = 0
+    while (i + BYTES_PER_CHUNK) < len(audio):
+        chunk = audio[i : i + BYTES_PER_CHUNK]
+        output = frontend.process_samples(chunk)
+        expected.extend(output.features)
+        i += BYTES_PER_CHUNK
+
+    # The same chunks in one call
+    frontend.reset()
+    output = frontend.process_audio(audio[:i])
+    assert output.bytes_read == i
+    assert output.features.format == "f"
+    assert output.features.shape == (len(expected) // 40, 40)
+    assert output.features.c_contiguous
+    assert output.features.cast("B").cast("f").tolist() == expected
+
+
+def test_process_audio_continues() -> None:
+    audio = read_wav("speech.wav")
+
+    frontend = MicroFrontend()
+    expected = frontend.process_audio(audio).features.tolist()
+
+    # Odd split, with a frame completed by the second call
+    frontend.reset()
+    first = frontend.process_audio(audio[:1001])
+    assert first.bytes_read == 1000
+    assert first.features.shape == (1, 40)
+    second = frontend.process_audio(audio[1000:])
+    assert second.bytes_read == len(audio) - 1000
+    assert first.features.tolist() + second.features.tolist() == expected
+
+    # Too little audio for a frame
+    frontend.reset()
+    output = frontend.process_audio(audio[:100])
+    assert output.bytes_read == 100
+    assert output.features.nbytes == 0
+
+
+def test_audio_buffers() -> None:
+    audio = read_wav("speech.wav")[: 10 * BYTES_PER_CHUNK]
+    frontend = MicroFrontend()
+    expected = frontend.process_audio(audio).features.tolist()
+
+    samples = array("h")
+    samples.frombytes(audio)
+    unaligned = bytearray(len(audio) + 1)
+    unaligned[1:] = audio
+    for buffer in (
+        bytearray(audio),
+        memoryview(audio),
+        samples,
+        memoryview(unaligned)[1:],
+    ):
+        frontend.reset()
+        assert frontend.process_audio(buffer).features.tolist() == expected
+
+        frontend.reset()
+        output = frontend.process_samples(buffer)
+        assert output.samples_read == 160
+
+    # Not 16-bit samples
+    with pytest.raises(TypeError):
+        frontend.process_audio(array("f", [0.0] * 480))
+
+    # Not contiguous
+    with pytest.raises(BufferError):
+        frontend.process_audio(memoryview(audio)[::2])
+
+
 def test_silence(snapshot: SnapshotAssertion) -> None:
     frontend = MicroFrontend()
     audio = read_wav("silence.wav")